@@ -11,6 +11,7 @@
 #include "pch.h"
 #include "AquariumApp.h"
 #include <MainFrame.h>
+#include <SpriteCache.h>
 
 /**
  * @class AquariumApp
@@ -33,6 +34,20 @@ bool AquariumApp::OnInit()
   // Initialize all image handlers for wxWidgets
   wxInitAllImageHandlers();
 
+  // Start decoding before the frame exists, so the images it needs
+  // right away, like the background, only wait for their own decode
+  auto &sprites = SpriteCache::Instance();
+  bool embedded = sprites.LoadEmbedded() > 0;
+  if (!embedded)
+  {
+   // Find the images no matter where we were started from
+   sprites.SetRoot(AssetLoader::FindRoot(L"images"));
+
+   // Decode every image on worker threads, the sprites are made
+   // on this thread once the last one is done
+   mAssetLoader.Start(L"images", [this]() { CallAfter([this]() { OnAssetsLoaded(); }); });
+  }
+
  // Create and initialize the main frame of the application
   auto frame = new MainFrame();
   frame->Initialize();
@@ -40,10 +55,34 @@ bool AquariumApp::OnInit()
  // show the main frame window.
   frame->Show(true);
 
+  if (embedded)
+  {
+   OnAssetsLoaded();
+  }
+
  // return true to indicate successful initialization.
   return true;
  }
 
+/**
+ * Make the sprites for every loaded image and start the simulation.
+ *
+ * Runs on the GUI thread once the asset loader is done. The simulation
+ * thread may not make sprites, so it only starts once they are all made.
+ */
+void AquariumApp::OnAssetsLoaded()
+{
+ mAssetLoader.Wait();
 
+ auto &sprites = SpriteCache::Instance();
+ sprites.LoadPending();
+ sprites.BuildAtlas();
+ sprites.SetGuiThread();
 
-
+ // The frame is gone if the window was closed while we were loading
+ auto frame = dynamic_cast<MainFrame *>(GetTopWindow());
+ if (frame != nullptr)
+ {
+  frame->StartSimulation();
+ }
+}
@@ -12,6 +12,7 @@
 #define AQUARIUM_AQUARIUMAPP_H
 
 #include <wx/wx.h>
+#include <AssetLoader.h>
 
 /**
  * @class AquariumApp
@@ -19,6 +20,12 @@
  * Handles the initialization of the aquarium application and the creation of the main window
  */
 class AquariumApp : public wxApp {
+private:
+ /// Decodes the sprites on worker threads while the window comes up
+ AssetLoader mAssetLoader;
+
+ void OnAssetsLoaded();
+
 public:
  /**
   * Initializes the application
@@ -14,7 +14,17 @@
 #include "FishDory.h"
 #include <algorithm>
 #include "DecorCastle.h"
+#include "ItemFactory.h"
 #include "Item.h"
+#include "Sprite.h"
+#include "SpriteCache.h"
+#include "SpriteAtlas.h"
+#include "SessionRecorder.h"
+#include "CounterRandom.h"
+#include "Log.h"
+#include <wx/mstream.h>
+#include <wx/ffile.h>
+#include <cstring>
 
 using namespace std;
 
@@ -23,50 +33,117 @@ const int InitialX = 200;
 /// initial y - coordinate for recently added item
 const int InitialY = 200; // initial y - coordinate for recently added item
 
+/// Length of one simulation step in seconds
+const double SimulationStep = 1.0 / 60.0;
+
+/// Most simulation steps to run for one frame before dropping time
+const int MaxCatchUpSteps = 5;
+
+/// Most commands the user interface can have waiting for the simulation
+const size_t CommandCapacity = 1024;
+
+/// Size of a cell of the item grid in pixels, about the size of a fish
+const double GridCellSize = 64;
+
+/// Every type of item a file can hold
+typedef ItemFactory<FishBeta, FishNemo, FishDory, DecorCastle> ItemTypes;
+
+/// Steps a fast forward runs on each chunk of fish while it is in cache
+const int FastForwardBatch = 60;
+
 /**
  * Aquarium Constructor
  *
  * initialize Aquarium background image (given)
  */
-Aquarium::Aquarium()
+Aquarium::Aquarium() : mWorld(make_shared<ItemWorld>()), mFish(mWorld), mArena(make_shared<ItemArena>()),
+    mClock(SimulationStep, MaxCatchUpSteps), mCommands(CommandCapacity)
 {
  random_device rd;
- mRandom.seed(rd());
+ Seed((uint64_t(rd()) << 32) | rd());
  // image from the folder "images"
- mBackground = make_unique<wxBitmap>(
-         L"images/background1.png", wxBITMAP_TYPE_ANY);
+ mBackground = SpriteCache::Instance().Load(L"images/background1.png");
+
+ mGrid.Resize(GetWidth(), GetHeight(), GridCellSize);
+}
+
+/**
+ * Destructor, finishes any recording
+ */
+Aquarium::~Aquarium()
+{
+ StopRecording();
+}
+
+/**
+ * Seed every random number the aquarium draws
+ * @param seed Seed value, the whole session follows from it
+ */
+void Aquarium::Seed(uint64_t seed)
+{
+ mRandom.seed(uint32_t(CounterRandom::Key(seed, 0)));
+ mFish.SetSeed(CounterRandom::Key(seed, 1));
 }
 
 /**
  * Draws the aquarium background and text.
  *
  * Responsible for rendering the background image of the aquarium
- * and displaying a title text at the top of the window.
+ * and displaying a title text at the top of the window. The items
+ * are drawn from a snapshot, the same way the painter draws the
+ * snapshots the simulation thread publishes.
  *
  * @param dc The device contact to draw on.
  */
 void Aquarium::OnDraw(wxDC *dc)
 {
- // setting image at (0,0) location
- dc->DrawBitmap(*mBackground, 0, 0);
+ // one atlas lookup per frame, items draw from it
+ mAtlas = SpriteCache::Instance().GetAtlas();
 
- // font for title "Under the Sea!"
- wxFont font(wxSize(0, 20),
-         wxFONTFAMILY_SWISS,
-         wxFONTSTYLE_NORMAL,
-         wxFONTWEIGHT_NORMAL);
- dc->SetFont(font);
- // color = MSU green
- dc->SetTextForeground(wxColour(0, 64, 0));
- // text quotes
- dc->DrawText(L"Under the Sea!", 10, 10);
+ Capture(mDrawSnapshot);
+ mDrawSnapshot.Draw(dc, mClock.GetAlpha(), &mStaticLayer);
+}
 
- // iterating each item in Aquarium
- for (auto item : mItems)
+/**
+ * Take a snapshot of everything needed to draw the aquarium
+ * @param snapshot Snapshot to fill in
+ */
+void Aquarium::Capture(Snapshot &snapshot)
+{
+ snapshot.Clear();
+ snapshot.SetBackground(mBackground);
+ snapshot.SetTiming(mClock.GetTicks(), mClock.GetStep(), mClock.GetAlpha());
+ Compact();
+
+ // iterating each item in Aquarium, back to front
+ size_t statics = 0;
+ bool behind = true;
+ for (auto &item : mItems)
  {
-  // draw current item
-  item->Draw(dc);
+  item->Capture(snapshot);
+  if (behind && item->IsStatic())
+  {
+   // Still in the run of static items behind everything that moves
+   statics = snapshot.GetEntries().size();
+  }
+  else
+  {
+   behind = false;
+  }
  }
+
+ snapshot.SetStatic(statics, mStaticVersion);
+}
+
+/**
+ * Take a snapshot and hand it to the painter.
+ *
+ * Only one thread may publish, normally the simulation thread.
+ */
+void Aquarium::Publish()
+{
+ Capture(mSnapshots.GetBack());
+ mSnapshots.Publish();
 }
 
 /**
@@ -80,10 +157,70 @@ void Aquarium::Add(std::shared_ptr<Item> item)
  item->SetLocation(InitialX, InitialY);
 
  // adding item to the list
+ NewHandle(item.get());
  mItems.push_back(item);
 
- // error check for debug
- std::cout << "Item added at " << item->GetX() << ", " << item->GetY() <<std::endl;
+ if (item->IsStatic())
+ {
+  StaticChanged();
+ }
+
+ AQUARIUM_LOG(Log::Level::Debug, "Item added at " << item->GetX() << ", " << item->GetY());
+}
+
+/**
+ * Add many items in one pass, leaving them where they are.
+ *
+ * Unlike Add, the items keep the locations they were given.
+ * Room is made for all of them first, then each gets a handle and
+ * goes in front of everything before it, just as with Add.
+ *
+ * @param items Items to add, back to front
+ */
+void Aquarium::AddMany(std::vector<std::shared_ptr<Item>> items)
+{
+ Compact();
+ mItems.reserve(mItems.size() + items.size());
+ mHandles.reserve(mItems.size() + items.size());
+
+ bool statics = false;
+ for (auto &item : items)
+ {
+  NewHandle(item.get());
+  statics = statics || item->IsStatic();
+  mItems.push_back(std::move(item));
+ }
+
+ if (statics)
+ {
+  StaticChanged();
+ }
+
+ AQUARIUM_LOG(Log::Level::Debug, "Added " << items.size() << " items");
+}
+
+/**
+ * Give an item about to go at the end of mItems a handle,
+ * reusing a free slot in the table if there is one
+ * @param item The item
+ */
+void Aquarium::NewHandle(Item *item)
+{
+ uint32_t index = mFreeHandle;
+ if (index != ItemHandle::NoIndex)
+ {
+  mFreeHandle = mHandles[index].nextFree;
+ }
+ else
+ {
+  index = (uint32_t)mHandles.size();
+  mHandles.emplace_back();
+ }
+
+ auto &slot = mHandles[index];
+ slot.item = item;
+ slot.position = (uint32_t)mItems.size();
+ item->mHandle = {index, slot.generation};
 }
 
 /**
@@ -91,44 +228,137 @@ void Aquarium::Add(std::shared_ptr<Item> item)
  * on some item in the aquarium.
  * @param x X location in pixels
  * @param y Y location in pixels
- * @returns Pointer to item we clicked on or nullptr if none.
+ * @returns Handle of the item we clicked on or a null handle if none.
 */
-std::shared_ptr<Item> Aquarium::HitTest(int x, int y)
+ItemHandle Aquarium::HitTest(int x, int y) const
 {
- // reversing iteration
+ // reversing iteration, skipping the holes
  for (auto i = mItems.rbegin(); i != mItems.rend();  i++)
  {
   // if clicked,
-  if ((*i)->HitTest(x, y))
+  if (*i != nullptr && (*i)->HitTest(x, y))
   {
    // return
-   return *i;
+   return (*i)->GetHandle();
   }
  }
-// if not clicked, return nullptr
- return  nullptr;
+// if not clicked, return a null handle
+ return ItemHandle();
 }
 
 /**
  * moves item to the front
  *
- * making sure given item will be drawn on top
+ * making sure given item will be drawn on top. The item is
+ * found through its handle and leaves a hole where it was,
+ * so this takes the same time however many items there are.
+ *
+ * @param handle Handle of the item to move front
+ */
+void Aquarium::MoveToFront(ItemHandle handle)
+{
+ if (Find(handle) == nullptr)
+ {
+  return;
+ }
+
+ auto &slot = mHandles[handle.index];
+ if (slot.position + 1 < mItems.size())
+ {
+  // move to the back, leaving a hole
+  mItems.push_back(std::move(mItems[slot.position]));
+  slot.position = (uint32_t)mItems.size() - 1;
+  mHoles++;
+
+  // Do not let holes pile up if nothing walks the list for a while
+  if (mHoles > mItems.size() / 2)
+  {
+   Compact();
+  }
+ }
+
+ // A static item moving changes what the static layer holds, a
+ // moving item changes at most how many static items it holds,
+ // which the layer notices itself
+ if (slot.item->IsStatic())
+ {
+  StaticChanged();
+ }
+}
+
+/**
+ * Take an item out of the aquarium.
+ *
+ * Its handle, and any copy of it, stops finding it at once.
  *
- * @param item A pointer to the item to move front
+ * @param handle Handle of the item to remove
+ */
+void Aquarium::Remove(ItemHandle handle)
+{
+ auto item = Find(handle);
+ if (item == nullptr)
+ {
+  return;
+ }
+
+ if (item->IsStatic())
+ {
+  StaticChanged();
+ }
+
+ auto position = mHandles[handle.index].position;
+ FreeHandle(handle);
+ mItems[position] = nullptr;
+ mHoles++;
+
+ // Do not let holes pile up if nothing walks the list for a while
+ if (mHoles > mItems.size() / 2)
+ {
+  Compact();
+ }
+}
+
+/**
+ * Give a handle table slot back, so its handles find nothing
+ * @param handle Handle of an item being taken out
  */
-void Aquarium::MoveToFront(std::shared_ptr<Item> item)
+void Aquarium::FreeHandle(ItemHandle handle)
 {
- // find item
- auto loc = std::find(mItems.begin(), mItems.end(), item);
+ auto &slot = mHandles[handle.index];
+ slot.item->mHandle = ItemHandle();
+ slot.item = nullptr;
+ slot.generation++;
+ slot.nextFree = mFreeHandle;
+ mFreeHandle = handle.index;
+}
 
- // if item found
- if (loc != end(mItems))
+/**
+ * Squeeze the holes left by MoveToFront and Remove out of
+ * the item list, keeping the order of the rest
+ */
+void Aquarium::Compact()
+{
+ if (mHoles == 0)
  {
-  // remove from current location
-  mItems.erase(loc);
-  // read item to the back
-  mItems.push_back(item);
+  return;
  }
+
+ size_t to = 0;
+ for (size_t from = 0; from < mItems.size(); from++)
+ {
+  if (mItems[from] != nullptr)
+  {
+   mHandles[mItems[from]->mHandle.index].position = (uint32_t)to;
+   if (to != from)
+   {
+    mItems[to] = std::move(mItems[from]);
+   }
+   to++;
+  }
+ }
+
+ mItems.resize(to);
+ mHoles = 0;
 }
 
 /**
@@ -137,46 +367,118 @@ void Aquarium::MoveToFront(std::shared_ptr<Item> item)
 * Open an XML file and stream the aquarium data to it.
 *
 * @param filename The filename of the file to save the aquarium to
+* @return false if the file could not be written
 */
-void Aquarium::Save(const wxString &filename)
+bool Aquarium::Save(const wxString &filename)
 {
  wxXmlDocument xmlDoc;
+ SaveDocument(xmlDoc);
 
+ if(!xmlDoc.Save(filename, wxXML_NO_INDENTATION))
+ {
+  AQUARIUM_LOG(Log::Level::Error, "Write to XML failed: " << filename.ToUTF8());
+  return false;
+ }
+
+ return true;
+}
+
+/**
+ * Save the aquarium as .aqua XML in memory
+ * @return The XML, just as Save would write it to a file
+ */
+std::string Aquarium::SaveData()
+{
+ wxXmlDocument xmlDoc;
+ SaveDocument(xmlDoc);
+
+ wxMemoryOutputStream stream;
+ xmlDoc.Save(stream, wxXML_NO_INDENTATION);
+
+ string data(size_t(stream.GetLength()), '\0');
+ stream.CopyTo(&data[0], data.size());
+ return data;
+}
+
+/**
+ * Build the XML document for the aquarium
+ * @param xmlDoc Empty document to fill in
+ */
+void Aquarium::SaveDocument(wxXmlDocument &xmlDoc)
+{
  auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"aqua");
  xmlDoc.SetRoot(root);
 
  // Iterate over all items and save them
- for (auto item : mItems)
+ Compact();
+ for (auto &item : mItems)
  {
   item->XmlSave(root);
  }
-
-
- if(!xmlDoc.Save(filename, wxXML_NO_INDENTATION))
- {
-  wxMessageBox(L"Write to XML failed");
-  return;
- }
 }
 /**
  * Load the aquarium from a .aqua XML file.
  *
  * Opens the XML file and reads the nodes, creating items as appropriate.
+ * A file that cannot be read is logged, see LoadFile.
  *
  * @param filename The filename of the file to load the aquarium from.
  */
 
 void Aquarium::Load(const wxString &filename)
+{
+ LoadFile(filename);
+}
+
+/**
+ * Load the aquarium from a .aqua XML file.
+ *
+ * A file that cannot be read is logged as an error and leaves the
+ * aquarium as it was, it is up to the caller to tell the user.
+ *
+ * @param filename The filename of the file to load the aquarium from.
+ * @return false if the file could not be read
+ */
+bool Aquarium::LoadFile(const wxString &filename)
 {
  wxXmlDocument xmlDoc;
  if(!xmlDoc.Load(filename))
  {
-  wxMessageBox(L"Unable to load Aquarium file");
-  return;
+  AQUARIUM_LOG(Log::Level::Error, "Unable to load Aquarium file: " << filename.ToUTF8());
+  return false;
  }
 
  Clear(filename);
+ LoadDocument(xmlDoc);
+ return true;
+}
+
+/**
+ * Load the aquarium from .aqua XML in memory, such as SaveData made
+ * @param data The XML
+ * @return false if the XML could not be read
+ */
+bool Aquarium::LoadData(const std::string &data)
+{
+ wxMemoryInputStream stream(data.data(), data.size());
+ wxXmlDocument xmlDoc;
+ if (!xmlDoc.Load(stream))
+ {
+  AQUARIUM_LOG(Log::Level::Error, "Unable to load Aquarium data of " << data.size() << " bytes");
+  return false;
+ }
+
+ Clear(L"");
+ LoadDocument(xmlDoc);
+ return true;
+}
 
+/**
+ * Create the items of an XML document, after the aquarium is cleared
+ * @param xmlDoc The document
+ */
+void Aquarium::LoadDocument(wxXmlDocument &xmlDoc)
+{
  // Get the XML document root node
  auto root = xmlDoc.GetRoot();
 
@@ -184,16 +486,32 @@ void Aquarium::Load(const wxString &filename)
  // Traverse the children of the root
  // node of the XML document in memory!!!!
  //
+ // Make room for everything at once
+ size_t count = 0;
+ for (auto node = root->GetChildren(); node; node = node->GetNext())
+ {
+  count++;
+ }
+ mFish.Reserve(count);
+
+ std::vector<std::shared_ptr<Item>> items;
+ items.reserve(count);
+
  auto child = root->GetChildren();
  for( ; child; child=child->GetNext())
  {
   auto name = child->GetName();
   if(name == L"item")
   {
-   XmlItem(child);
+   auto item = XmlItem(child);
+   if (item != nullptr)
+   {
+    items.push_back(std::move(item));
+   }
   }
  }
 
+ AddMany(std::move(items));
 }
 
 
@@ -203,58 +521,527 @@ void Aquarium::Load(const wxString &filename)
  */
 void Aquarium::Clear(const wxString &filename)
 {
+ for (auto &item : mItems)
+ {
+  if (item != nullptr)
+  {
+   FreeHandle(item->mHandle);
+  }
+ }
+
  mItems.clear();
+ mHoles = 0;
+ StaticChanged();
+
+ // Hand the item memory back in bulk, unless someone still holds an item
+ mArena->Release();
+}
+
+/**
+ * Empty the aquarium and start it over from a seed.
+ *
+ * The clock goes back to no ticks and free handles are handed
+ * out lowest first, so with the same generations (see
+ * SetGenerations) and the same commands and frames what follows
+ * happens the same way in any aquarium.
+ *
+ * @param seed Seed for every random number from now on
+ */
+void Aquarium::Restart(uint64_t seed)
+{
+ Clear(L"");
+ Seed(seed);
+ mClock.Reset();
+
+ // Every slot is free now, line them up lowest first
+ SetGenerations(GetGenerations());
+}
+
+/**
+ * Get the generation of every slot in the handle table
+ * @return Generations, indexed by ItemHandle::index
+ */
+std::vector<uint32_t> Aquarium::GetGenerations() const
+{
+ vector<uint32_t> generations;
+ generations.reserve(mHandles.size());
+ for (auto &slot : mHandles)
+ {
+  generations.push_back(slot.generation);
+ }
+
+ return generations;
+}
+
+/**
+ * Make the handle table the same as one saved by GetGenerations,
+ * so items get the same handles they did there. Only for an
+ * aquarium just restarted, with no items.
+ * @param generations Generations, indexed by ItemHandle::index
+ */
+void Aquarium::SetGenerations(const std::vector<uint32_t> &generations)
+{
+ mHandles.resize(max(mHandles.size(), generations.size()));
+ for (size_t i = 0; i < generations.size(); i++)
+ {
+  mHandles[i].generation = generations[i];
+ }
+
+ mFreeHandle = ItemHandle::NoIndex;
+ for (auto index = (uint32_t)mHandles.size(); index-- > 0; )
+ {
+  mHandles[index].nextFree = mFreeHandle;
+  mFreeHandle = index;
+ }
+}
+
+/**
+ * Hash everything that decides what the aquarium does next: the
+ * clock, the random numbers and each item's handle, type, location,
+ * mirror flag and speed, in drawing order.
+ *
+ * Two aquariums that hash the same are, as far as anyone can tell,
+ * in the same state.
+ *
+ * @return The hash
+ */
+uint64_t Aquarium::GetStateHash() const
+{
+ uint64_t hash = 0;
+ auto mix = [&hash](uint64_t value) { hash = CounterRandom::Get(hash, value); };
+ auto bits = [](double value) {
+  uint64_t result;
+  memcpy(&result, &value, sizeof(result));
+  return result;
+ };
+
+ mix(mClock.GetTicks());
+ auto random = mRandom;
+ mix(random());
+
+ // Skip the holes rather than compacting, so the hash only reads
+ mix(GetItemCount());
+ ForEachItem([&](const Item &item) {
+  auto handle = item.GetHandle();
+  mix((uint64_t(handle.index) << 32) | handle.generation);
+
+  auto entity = item.GetEntity();
+  if (mWorld->Has(entity, Component::Persist) && mWorld->GetType(entity) != nullptr)
+  {
+   for (auto type = mWorld->GetType(entity); *type != 0; type++)
+   {
+    mix(uint64_t(*type));
+   }
+  }
+
+  mix(bits(item.GetX()));
+  mix(bits(item.GetY()));
+  mix(item.GetMirror() ? 1 : 0);
+  if (mWorld->Has(entity, Component::Velocity))
+  {
+   mix(bits(mWorld->GetSpeedX(entity)));
+   mix(bits(mWorld->GetSpeedY(entity)));
+  }
+ });
+
+ return hash;
+}
+
+/**
+ * Start recording the session to a file.
+ *
+ * The aquarium is restarted from a new seed and then loaded with
+ * what it held, and that load is the first thing recorded, so a
+ * replay starts from exactly the same state. Any recording already
+ * going is stopped first.
+ *
+ * @param filename File to record to
+ * @return false if the file could not be created, the aquarium is left alone
+ */
+bool Aquarium::StartRecording(const std::wstring &filename)
+{
+ StopRecording();
+
+ auto recorder = make_unique<SessionRecorder>();
+ if (!recorder->Open(filename))
+ {
+  AQUARIUM_LOG(Log::Level::Error, "Unable to record to " << wxString(filename).ToUTF8());
+  return false;
+ }
+
+ AquariumCommand load;
+ load.type = AquariumCommand::Type::Load;
+ load.data = SaveData();
+
+ random_device rd;
+ uint64_t seed = (uint64_t(rd()) << 32) | rd();
+ Restart(seed);
+ recorder->Begin(seed, mFish.GetSchooling().IsEnabled(), GetGenerations());
+ mRecorder = std::move(recorder);
+
+ mRecorder->Command(load);
+ Execute(load);
+ return true;
+}
+
+/**
+ * Stop recording the session, if it is being recorded
+ * @return false if the log could not be written in full
+ */
+bool Aquarium::StopRecording()
+{
+ if (mRecorder == nullptr)
+ {
+  return true;
+ }
+
+ bool ok = mRecorder->Close(*this);
+ mRecorder = nullptr;
+ if (!ok)
+ {
+  AQUARIUM_LOG(Log::Level::Error, "Unable to write the whole recording");
+ }
+ return ok;
 }
 
 /**
  * Handle a node of type item.
  * @param node XML node
+ * @return The item it describes, not yet added, or nullptr for an unknown type
  */
-void Aquarium::XmlItem(wxXmlNode *node)
+std::shared_ptr<Item> Aquarium::XmlItem(wxXmlNode *node)
 {
- // A pointer for the item we are loading
- shared_ptr<Item> item;
-
  // We have an item. What type?
- auto type = node->GetAttribute(L"type");
- if (type == L"beta")
+ auto item = Create(node->GetAttribute(L"type").ToStdWstring());
+
+ if (item != nullptr)
  {
-  item = make_shared<FishBeta>(this);
+  item->XmlLoad(node);
  }
 
- if (type == L"castle")
+ return item;
+}
+
+/**
+ * Create an item from the type name it is saved under.
+ *
+ * The item and its reference count are made in one slot of the
+ * arena pool for its species.
+ *
+ * @param type Type name, such as L"beta"
+ * @return The new item, not yet added, or nullptr for an unknown type
+ */
+std::shared_ptr<Item> Aquarium::Create(const std::wstring &type)
+{
+ return ItemTypes::Create(type.c_str(), this, mArena);
+}
+
+/**
+ * Find one of our items from its handle
+ * @param handle Handle of the item, such as one a snapshot reported
+ * @return The item or nullptr if it is no longer in the aquarium
+ */
+Item *Aquarium::Find(ItemHandle handle) const
+{
+ if (handle.index >= mHandles.size())
  {
-  item = make_shared<DecorCastle>(this);
+  return nullptr;
  }
 
- if (type == L"nemo")
+ auto &slot = mHandles[handle.index];
+ return slot.generation == handle.generation ? slot.item : nullptr;
+}
+
+/**
+ * Send a change to be made before the next simulation step.
+ *
+ * Only one thread may send, normally the GUI thread. This never
+ * waits, if the queue is full it fails and the caller can try
+ * again later.
+ *
+ * @param command The change to make, moved from only on success
+ * @return false if the queue is full
+ */
+bool Aquarium::Send(AquariumCommand &&command)
+{
+ return mCommands.TryPush(std::move(command));
+}
+
+/**
+ * Carry out every command sent so far.
+ *
+ * Called by the simulation thread between steps. A run of moves
+ * of the same item only carries out the last one, since that is
+ * where the item ends up anyway. While the session is being
+ * recorded, each command is recorded just before it is carried out.
+ *
+ * @return Number of commands carried out
+ */
+int Aquarium::ExecuteCommands()
+{
+ mCommandBatch.clear();
+
+ AquariumCommand command;
+ while (mCommands.TryPop(command))
  {
-  item = make_shared<FishNemo>(this);
+  mCommandBatch.push_back(std::move(command));
  }
 
- if (type == L"dory")
+ int executed = 0;
+ for (size_t i = 0; i < mCommandBatch.size(); i++)
  {
-  item = make_shared<FishDory>(this);
+  auto &current = mCommandBatch[i];
+  if (current.type == AquariumCommand::Type::Move && i + 1 < mCommandBatch.size())
+  {
+   auto &next = mCommandBatch[i + 1];
+   if (next.type == AquariumCommand::Type::Move && next.item == current.item)
+   {
+    continue;
+   }
+  }
+
+  if (mRecorder != nullptr && current.type != AquariumCommand::Type::Record &&
+      current.type != AquariumCommand::Type::StopRecording)
+  {
+   if (current.type == AquariumCommand::Type::Load && current.data.empty())
+   {
+    // Record what was in the file, it may not be there for the replay
+    wxFFile file(current.name, "rb");
+    if (file.IsOpened())
+    {
+     current.data.resize(size_t(file.Length()));
+     current.data.resize(file.Read(&current.data[0], current.data.size()));
+    }
+   }
+
+   mRecorder->Command(current);
+  }
+
+  Execute(current);
+  executed++;
  }
 
- if (item != nullptr)
+ return executed;
+}
+
+/**
+ * Carry out one command
+ * @param command The command
+ */
+void Aquarium::Execute(const AquariumCommand &command)
+{
+ switch (command.type)
+ {
+ case AquariumCommand::Type::Add:
+ {
+  auto item = Create(command.name);
+  if (item != nullptr)
+  {
+   Add(item);
+  }
+  break;
+ }
+
+ case AquariumCommand::Type::Move:
+ {
+  auto item = Find(command.item);
+  if (item != nullptr)
+  {
+   item->SetLocation(command.x, command.y);
+  }
+  break;
+ }
+
+ case AquariumCommand::Type::BringToFront:
  {
+  MoveToFront(command.item);
+  break;
+ }
 
-  Add(item);
+ case AquariumCommand::Type::Load:
+ {
+  bool loaded = command.data.empty() ? LoadFile(command.name) : LoadData(command.data);
+  if (!loaded && wxTheApp != nullptr)
+  {
+   // Tell the user from the GUI thread
+   wxTheApp->CallAfter([]() { wxMessageBox(L"Unable to load Aquarium file"); });
+  }
+  break;
+ }
 
-  item->XmlLoad(node);
+ case AquariumCommand::Type::Clear:
+  Clear(L"");
+  break;
+
+ case AquariumCommand::Type::Schooling:
+  mFish.GetSchooling().SetEnabled(command.enabled);
+  break;
+
+ case AquariumCommand::Type::Record:
+  if (!StartRecording(command.name) && wxTheApp != nullptr)
+  {
+   wxTheApp->CallAfter([]() { wxMessageBox(L"Unable to record to file"); });
+  }
+  break;
+
+ case AquariumCommand::Type::StopRecording:
+  if (!StopRecording() && wxTheApp != nullptr)
+  {
+   wxTheApp->CallAfter([]() { wxMessageBox(L"Unable to write the whole recording"); });
+  }
+  break;
+
+ default:
+  break;
  }
 }
 
 /**
  * Handle updates for animation
+ *
+ * Runs the systems of the item world, each over the tables
+ * of entities that have its components. Static items such
+ * as decor have no Velocity and are never visited.
+ *
  * @param elapsed The time since the last update
  */
 void Aquarium::Update(double elapsed)
 {
- for (auto item : mItems)
+ mFish.Update(elapsed, GetWidth(), GetHeight());
+}
+
+/**
+ * Advance the simulation by the time since the last frame.
+ *
+ * The time is simulated in fixed steps, and fish are drawn
+ * between the last two steps by however much time is left over.
+ * A long stall only runs a few steps, the rest is dropped.
+ *
+ * @param elapsed Time since the last frame in seconds
+ * @return Number of steps simulated
+ */
+int Aquarium::Advance(double elapsed)
+{
+ auto steps = mClock.Advance(elapsed);
+ for (int i = 0; i < steps; i++)
+ {
+  Update(mClock.GetStep());
+ }
+
+ mFish.SetInterpolation(mClock.GetAlpha());
+ UpdateGrid();
+
+ if (mRecorder != nullptr)
+ {
+  mRecorder->Frame(elapsed, *this);
+ }
+
+ return steps;
+}
+
+/**
+ * Simulate a stretch of time as fast as possible.
+ *
+ * Nothing waits for a frame and nothing is drawn. The steps
+ * are run in batches (see ItemWorld::Update), and the grid is
+ * only rebuilt at the end. Unlike Advance no time is dropped,
+ * so this is for ageing a tank or soak testing, not for frames.
+ *
+ * @param seconds Time to simulate in seconds, rounded to whole steps
+ * @return Number of steps simulated
+ */
+uint64_t Aquarium::FastForward(double seconds)
+{
+ auto step = mClock.GetStep();
+ auto steps = seconds > 0 ? uint64_t(seconds / step + 0.5) : 0;
+ for (uint64_t done = 0; done < steps; )
+ {
+  auto batch = (int)min<uint64_t>(FastForwardBatch, steps - done);
+  mFish.Update(step, GetWidth(), GetHeight(), batch);
+  done += batch;
+ }
+
+ mClock.Skip(steps);
+ mFish.SetInterpolation(mClock.GetAlpha());
+ UpdateGrid();
+
+ if (mRecorder != nullptr)
+ {
+  mRecorder->FastForward(steps);
+ }
+
+ return steps;
+}
+
+/**
+ * Rebuild the grid of item locations.
+ *
+ * Advance does this every frame. Anything that moves items
+ * some other way and then queries should call it first.
+ */
+void Aquarium::UpdateGrid()
+{
+ Compact();
+ mGridX.resize(mItems.size());
+ mGridY.resize(mItems.size());
+ mGridHandles.resize(mItems.size());
+ for (size_t i = 0; i < mItems.size(); i++)
+ {
+  mGridX[i] = mItems[i]->GetX();
+  mGridY[i] = mItems[i]->GetY();
+  mGridHandles[i] = mItems[i]->GetHandle();
+ }
+
+ mGrid.Build(mGridX.data(), mGridY.data(), mItems.size());
+}
+
+/**
+ * Find the items whose centers are within a distance of a location
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ * @param radius Distance in pixels
+ * @param items Cleared and filled with the items, back to front
+ */
+void Aquarium::QueryRadius(double x, double y, double radius, std::vector<Item *> &items) const
+{
+ vector<int> indices;
+ mGrid.QueryRadius(x, y, radius, indices);
+ GridItems(indices, items);
+}
+
+/**
+ * Find the items whose centers are inside a rectangle
+ * @param left Left edge in pixels
+ * @param top Top edge in pixels
+ * @param right Right edge in pixels
+ * @param bottom Bottom edge in pixels
+ * @param items Cleared and filled with the items, back to front
+ */
+void Aquarium::QueryRect(double left, double top, double right, double bottom, std::vector<Item *> &items) const
+{
+ vector<int> indices;
+ mGrid.QueryRect(left, top, right, bottom, indices);
+ GridItems(indices, items);
+}
+
+/**
+ * Turn grid indices into items in drawing order
+ * @param indices Indices from the grid, sorted in place
+ * @param items Cleared and filled with the items
+ */
+void Aquarium::GridItems(std::vector<int> &indices, std::vector<Item *> &items) const
+{
+ sort(indices.begin(), indices.end());
+
+ items.clear();
+ for (auto index : indices)
  {
-  item->Update(elapsed);
+  // Items removed since the grid was built are left out
+  auto item = Find(mGridHandles[index]);
+  if (item != nullptr)
+  {
+   items.push_back(item);
+  }
  }
 }
 
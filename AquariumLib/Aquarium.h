@@ -14,9 +14,21 @@
 #include <memory> // To use unique_ptr
 #include <random>
 #include "Item.h"
+#include "Sprite.h"
+#include "FishStore.h"
+#include "SimulationClock.h"
+#include "SnapshotBuffer.h"
+#include "SpscQueue.h"
+#include "AquariumCommand.h"
+#include "SpatialGrid.h"
+#include "StaticLayer.h"
+#include "ItemArena.h"
+#include <mutex>
 
 // declaration of the class Item
 class Item;
+class SpriteAtlas;
+class SessionRecorder;
 
 /**
  * @class Aquarium
@@ -30,17 +42,100 @@ class Aquarium
 {
 private:
  /// background image
- std::unique_ptr<wxBitmap> mBackground;
+ std::shared_ptr<const Sprite> mBackground;
 
- /// All of the items to populate our aquarium
+ /// Components of every item, shared with the items so they can outlive the aquarium
+ std::shared_ptr<ItemWorld> mWorld;
+
+ /// The fish in the world by slot
+ FishStore mFish;
+
+ /// Memory the items are created in, one pool per species
+ std::shared_ptr<ItemArena> mArena;
+
+ /**
+  * All of the items to populate our aquarium, back to front.
+  *
+  * Moving an item to the front or removing it leaves a null
+  * behind, and the nulls are squeezed out by Compact the next
+  * time the whole list is walked.
+  */
  std::vector<std::shared_ptr<Item>> mItems;
 
- void XmlItem(wxXmlNode* node);
+ /// Number of nulls in mItems
+ size_t mHoles = 0;
+
+ /// One entry of the handle table
+ struct HandleSlot {
+  Item *item = nullptr;        ///< Item using the slot, null if free
+  uint32_t generation = 0;     ///< Goes up each time the slot is freed
+  uint32_t position = 0;       ///< Where the item is in mItems
+  uint32_t nextFree = ItemHandle::NoIndex;   ///< Next free slot if this one is free
+ };
+
+ /// Handle table, indexed by ItemHandle::index
+ std::vector<HandleSlot> mHandles;
+
+ /// First free slot in the handle table
+ uint32_t mFreeHandle = ItemHandle::NoIndex;
+
+ std::shared_ptr<Item> XmlItem(wxXmlNode* node);
  //void Update(double elapsed);
 
  /// Random number generator
  std::mt19937 mRandom;
 
+ /// Sprite atlas items draw from, picked up at the start of each draw
+ std::shared_ptr<const SpriteAtlas> mAtlas;
+
+ /// Turns frame times into fixed simulation steps
+ SimulationClock mClock;
+
+ /// Held by whichever thread is changing the aquarium
+ std::mutex mMutex;
+
+ /// Snapshots handed from the simulation thread to the painter
+ SnapshotBuffer mSnapshots;
+
+ /// Snapshot OnDraw fills in and draws
+ Snapshot mDrawSnapshot;
+
+ /// Background and decor OnDraw draws once and reuses
+ StaticLayer mStaticLayer;
+
+ /// Changes whenever a static item is added, moved or reordered
+ uint64_t mStaticVersion = 0;
+
+ /// Changes sent by the user interface, waiting for the next step
+ SpscQueue<AquariumCommand> mCommands;
+
+ /// Commands taken off the queue by ExecuteCommands
+ std::vector<AquariumCommand> mCommandBatch;
+
+ /// Items bucketed by where they are, rebuilt by UpdateGrid
+ SpatialGrid mGrid;
+
+ /// X locations of the items when the grid was last built
+ std::vector<double> mGridX;
+
+ /// Y locations of the items when the grid was last built
+ std::vector<double> mGridY;
+
+ /// Handles of the items when the grid was last built
+ std::vector<ItemHandle> mGridHandles;
+
+ /// Records the session while recording is on, null otherwise
+ std::unique_ptr<SessionRecorder> mRecorder;
+
+ void Execute(const AquariumCommand &command);
+ void NewHandle(Item *item);
+ void Seed(uint64_t seed);
+ void SaveDocument(wxXmlDocument &xmlDoc);
+ void LoadDocument(wxXmlDocument &xmlDoc);
+ void Compact();
+ void FreeHandle(ItemHandle handle);
+ void GridItems(std::vector<int> &indices, std::vector<Item *> &items) const;
+
 public:
  /**
  * Constructor for Aquarium.
@@ -48,18 +143,67 @@ public:
  * Initializes the aquarium by loading the background image.
  */
  Aquarium(); // Constructor declaration
+ ~Aquarium();
+
+ /// Copy constructor (disabled)
+ Aquarium(const Aquarium &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const Aquarium &) = delete;
 
 
  void OnDraw(wxDC* dc);
 
+ void Capture(Snapshot &snapshot);
+ void Publish();
+
+ /**
+  * Note that a static item was added, moved or reordered,
+  * so the cached static layer has to be drawn again
+  */
+ void StaticChanged() { mStaticVersion++; }
+
+ /**
+  * Lock the aquarium against changes from other threads.
+  *
+  * Anything that changes or looks at the items while the
+  * simulation thread is running must hold this lock.
+  *
+  * @return The held lock
+  */
+ std::unique_lock<std::mutex> Lock() { return std::unique_lock<std::mutex>(mMutex); }
+
+ bool Send(AquariumCommand &&command);
+ int ExecuteCommands();
+
+ /**
+  * Get the snapshots published by Publish
+  * @return Reference to the snapshot buffer
+  */
+ SnapshotBuffer &GetSnapshots() { return mSnapshots; }
+
 
  void Add(std::shared_ptr<Item> item);
+ void AddMany(std::vector<std::shared_ptr<Item>> items);
+ std::shared_ptr<Item> Create(const std::wstring &type);
+ Item *Find(ItemHandle handle) const;
+ void Remove(ItemHandle handle);
 
 
- std::shared_ptr<Item> HitTest(int x, int y);
+ ItemHandle HitTest(int x, int y) const;
+
+ void UpdateGrid();
+ void QueryRadius(double x, double y, double radius, std::vector<Item *> &items) const;
+ void QueryRect(double left, double top, double right, double bottom, std::vector<Item *> &items) const;
+
+ /**
+  * Get the grid of item locations
+  * @return Grid as of the last UpdateGrid, indices are into GetFishes()
+  */
+ const SpatialGrid &GetGrid() const { return mGrid; }
 
 
- void MoveToFront(std::shared_ptr<Item> item);
+ void MoveToFront(ItemHandle handle);
 
  /**
   * return list of items
@@ -70,13 +214,61 @@ public:
   *
   * @return const reference to the vector of shared pointer
   */
- const std::vector<std::shared_ptr<Item>>& GetFishes() const {return mItems;}
+ const std::vector<std::shared_ptr<Item>>& GetFishes() { Compact(); return mItems; }
 
- void Save(const wxString &filename);
+ /**
+  * Number of items in the aquarium
+  * @return Item count, not counting holes
+  */
+ size_t GetItemCount() const { return mItems.size() - mHoles; }
+
+ /**
+  * Visit every item back to front without changing the list,
+  * for readers that do not need GetFishes() indices
+  * @param visit Called with each item
+  */
+ template <class Visitor>
+ void ForEachItem(Visitor &&visit) const
+ {
+  for (auto &item : mItems)
+  {
+   if (item != nullptr)
+   {
+    visit(*item);
+   }
+  }
+ }
+
+ bool Save(const wxString &filename);
  void Load(const wxString& filename);
+ bool LoadFile(const wxString& filename);
+ std::string SaveData();
+ bool LoadData(const std::string &data);
  void Clear(const wxString& filename);
 
+ void Restart(uint64_t seed);
+ std::vector<uint32_t> GetGenerations() const;
+ void SetGenerations(const std::vector<uint32_t> &generations);
+ uint64_t GetStateHash() const;
+
+ bool StartRecording(const std::wstring &filename);
+ bool StopRecording();
+
+ /**
+  * Is the session being recorded?
+  * @return true between StartRecording and StopRecording
+  */
+ bool IsRecording() const { return mRecorder != nullptr; }
+
  void Update(double elapsed);
+ int Advance(double elapsed);
+ uint64_t FastForward(double seconds);
+
+ /**
+  * Get the clock that paces the simulation
+  * @return Reference to the clock
+  */
+ const SimulationClock &GetClock() const { return mClock; }
 
  /**
     * Get the random number generator
@@ -84,6 +276,24 @@ public:
     */
  std::mt19937 &GetRandom() { return mRandom; }
 
+ /**
+  * Get the arena items are created in
+  * @return Reference to the arena
+  */
+ const ItemArena &GetArena() const { return *mArena; }
+
+ /**
+  * Get the store holding the moving state of the fish
+  * @return Reference to the fish store
+  */
+ FishStore &GetFishStore() { return mFish; }
+
+ /**
+  * Get the world holding the components of every item
+  * @return Pointer to the world
+  */
+ const std::shared_ptr<ItemWorld> &GetWorld() const { return mWorld; }
+
  /**
 * Get the width of the aquarium
 * @return Aquarium width in pixels
@@ -95,5 +305,11 @@ public:
   * @return Aquarium height in pixels
   */
  int GetHeight() const { return mBackground->GetHeight(); }
+
+ /**
+  * Get the sprite atlas for the frame being drawn
+  * @return Pointer to the atlas or nullptr if there is none
+  */
+ const SpriteAtlas *GetAtlas() const { return mAtlas.get(); }
 };
 #endif //AQUARIUM_H
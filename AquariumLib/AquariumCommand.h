@@ -0,0 +1,36 @@
+/**
+ * @file AquariumCommand.h
+ * @author Yeji Lee
+ *
+ * Declaration of the AquariumCommand struct.
+ *
+ * A change to the aquarium asked for by the user interface and
+ * carried out by the simulation thread between steps.
+ */
+
+#ifndef AQUARIUM_AQUARIUMCOMMAND_H
+#define AQUARIUM_AQUARIUMCOMMAND_H
+
+#include <string>
+#include "ItemHandle.h"
+
+/**
+ * One request from the user interface to change the aquarium.
+ *
+ * Items are named by the handle a Snapshot reports for them, so
+ * a command for an item that has since gone does nothing.
+ */
+struct AquariumCommand {
+ /// What to do
+ enum class Type {None, Add, Move, BringToFront, Load, Clear, Schooling, Record, StopRecording};
+
+ Type type = Type::None;      ///< What to do
+ ItemHandle item;             ///< Item to move or bring to front
+ double x = 0;                ///< Location to move the item to
+ double y = 0;                ///< Location to move the item to
+ std::wstring name;           ///< Type of item to add, file to load or file to record to
+ std::string data;            ///< Contents of the file to load, read from name if empty
+ bool enabled = false;        ///< Whether to turn schooling on or off
+};
+
+#endif //AQUARIUM_AQUARIUMCOMMAND_H
@@ -18,6 +18,7 @@
 #include "FishDory.h"
 #include "DecorCastle.h"
 #include "Item.h"
+#include "StartupTimer.h"
 
 using namespace std;
 
@@ -48,7 +49,10 @@ void AquariumView::Initialize(wxFrame* parent)
  parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnAddFishNemoFish, this, IDM_ADDFISHNEMO);
  parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnAddFishDoryFish, this, IDM_ADDFISHDORY);
  parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnAddDecorCastle, this, IDM_ADDDECORCASTLE);
+ parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnSchooling, this, IDM_SCHOOLING);
  parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnFileSaveAs, this, wxID_SAVEAS);
+ parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnRecord, this, IDM_RECORD);
+ parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &AquariumView::OnStopRecording, this, IDM_STOPRECORDING);
 
  // bind mouse event
  Bind(wxEVT_LEFT_DOWN, &AquariumView::OnLeftDown, this);
@@ -58,15 +62,27 @@ void AquariumView::Initialize(wxFrame* parent)
 
  mTimer.SetOwner(this);
  mTimer.Start(FrameDuration);
+}
 
- mStopWatch.Start();
+/**
+ * Start the thread that runs the simulation.
+ *
+ * The view paints nothing but the background colour until then, and
+ * commands sent before it wait in the queue. Only call it once every
+ * sprite the simulation may ask for has been made, since the
+ * simulation thread may not make them.
+ */
+void AquariumView::StartSimulation()
+{
+ mSimulation.Start();
 }
 
 /**
  * Handles the paint event to draw the aquarium.
  *
  * Uses wxAutoBufferedPaintDC to avoid flickering, sets the background color to white,
- * and calls the OnDraw method of the Aquarium class to render the aquarium content.
+ * and draws the newest snapshot the simulation thread has published. Painting never
+ * waits for the simulation.
  *
  * @param event The paint event triggered by wxWidgets.
  */
@@ -76,21 +92,30 @@ void AquariumView::OnPaint(wxPaintEvent& event)
  wxAutoBufferedPaintDC dc(this); // Use double-buffering to prevent flickering
 
 
- // Compute the time that has elapsed
- // since the last call to OnPaint.
- auto newTime = mStopWatch.Time();
- auto elapsed = (double)(newTime - mTime) * 0.001;
- mTime = newTime;
-
- mAquarium.Update(elapsed);
-
  // Sets the background color to white and clear the device context.
  wxBrush background(*wxWHITE);
  dc.SetBackground(background);
  dc.Clear();
 
- // Call the OnDraw method of the Aquarium class to render the aquarium content.
- mAquarium.OnDraw(&dc);
+ // Draw the aquarium as of the last simulation step, carried
+ // forward to now by interpolating from the step before
+ auto snapshot = mAquarium.GetSnapshots().Acquire();
+ if (snapshot != nullptr)
+ {
+  snapshot->Draw(&dc, snapshot->GetAlpha(Snapshot::Clock::now()), &mStaticLayer);
+ }
+
+ // The first frame ends the cold start, show how long it took
+ if (!StartupTimer::HasFirstFrame())
+ {
+  StartupTimer::MarkFirstFrame();
+
+  auto frame = dynamic_cast<wxFrame *>(GetParent());
+  if (frame != nullptr)
+  {
+   frame->SetStatusText(wxString::Format(L"Cold start: %.0f ms", StartupTimer::GetColdStartSeconds() * 1000));
+  }
+ }
 }
 
 /**
@@ -99,11 +124,25 @@ void AquariumView::OnPaint(wxPaintEvent& event)
  */
 void AquariumView::OnAddFishBetaFish(wxCommandEvent& event)
 {
- auto fish = make_shared<FishBeta>(&mAquarium);
- mAquarium.Add(fish);
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Add;
+ command.name = L"beta";
+ Send(std::move(command));
  Refresh();
 }
 
+/**
+ * Menu handler for Add Fish>Schooling, turns schooling on or off
+ * @param event Menu event, checked if schooling should be on
+ */
+void AquariumView::OnSchooling(wxCommandEvent& event)
+{
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Schooling;
+ command.enabled = event.IsChecked();
+ Send(std::move(command));
+}
+
 /**
  * menu handler for adding nemo fish
  *
@@ -113,8 +152,10 @@ void AquariumView::OnAddFishBetaFish(wxCommandEvent& event)
  */
 void AquariumView::OnAddFishNemoFish(wxCommandEvent& event)
 {
- auto fish = make_shared<FishNemo>(&mAquarium);
- mAquarium.Add(fish);
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Add;
+ command.name = L"nemo";
+ Send(std::move(command));
  Refresh();
 }
 
@@ -127,8 +168,10 @@ void AquariumView::OnAddFishNemoFish(wxCommandEvent& event)
  */
 void AquariumView::OnAddFishDoryFish(wxCommandEvent& event)
 {
- auto fish = make_shared<FishDory>(&mAquarium);
- mAquarium.Add(fish);
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Add;
+ command.name = L"dory";
+ Send(std::move(command));
  Refresh();
 }
 
@@ -141,8 +184,10 @@ void AquariumView::OnAddFishDoryFish(wxCommandEvent& event)
  */
 void AquariumView::OnAddDecorCastle(wxCommandEvent& event)
 {
- auto fish = make_shared<DecorCastle>(&mAquarium);
- mAquarium.Add(fish);
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Add;
+ command.name = L"castle";
+ Send(std::move(command));
  Refresh();
 }
 
@@ -154,13 +199,17 @@ void AquariumView::OnAddDecorCastle(wxCommandEvent& event)
  */
 void AquariumView::OnLeftDown(wxMouseEvent &event)
 {
- // checking if the click hit any item
- mGrabbedItem = mAquarium.HitTest(event.GetX(), event.GetY());
- if (mGrabbedItem != nullptr)
+ // checking if the click hit any item, in what the user sees
+ auto snapshot = mAquarium.GetSnapshots().Acquire();
+ mGrabbedItem = snapshot != nullptr ? snapshot->HitTest(event.GetX(), event.GetY()) : ItemHandle();
+ if (!mGrabbedItem.IsNull())
  {
   // We have selected an item
   // Move it to the end of the list of items
-  mAquarium.MoveToFront(mGrabbedItem);
+  AquariumCommand command;
+  command.type = AquariumCommand::Type::BringToFront;
+  command.item = mGrabbedItem;
+  Send(std::move(command));
 
   // refresh to show change
   Refresh();
@@ -190,16 +239,21 @@ OnMouseMove(event);
 void AquariumView::OnMouseMove(wxMouseEvent &event)
 {
  // See if an item is currently being moved by the mouse
- if (mGrabbedItem != nullptr){
+ if (!mGrabbedItem.IsNull()){
   // If an item is being moved, we only continue to
   // move it while the left button is down.
   if (event.LeftIsDown())
   {
-   mGrabbedItem->SetLocation(event.GetX(), event.GetY());
+   AquariumCommand command;
+   command.type = AquariumCommand::Type::Move;
+   command.item = mGrabbedItem;
+   command.x = event.GetX();
+   command.y = event.GetY();
+   Send(std::move(command));
   } else {
    // When the left button is released, we release the
    // item.
-   mGrabbedItem = nullptr;
+   mGrabbedItem = ItemHandle();
   }
 
   // Force the screen to redraw
@@ -221,7 +275,17 @@ void AquariumView::OnFileSaveAs(wxCommandEvent &event)
   }
 
   auto filename = saveFileDialog.GetPath();
- mAquarium.Save(filename);
+ bool saved;
+ {
+  auto lock = mAquarium.Lock();
+  saved = mAquarium.Save(filename);
+ }
+
+ // Tell the user once the simulation can carry on
+ if (!saved)
+ {
+  wxMessageBox(L"Write to XML failed");
+ }
  }
 
 /**
@@ -237,17 +301,80 @@ void AquariumView::OnFileOpen(wxCommandEvent& event)
   return;
  }
 
- auto filename = loadFileDialog.GetPath();
- mAquarium.Load(filename);
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Load;
+ command.name = loadFileDialog.GetPath().ToStdWstring();
+ Send(std::move(command));
  Refresh();
 
 }
 
+/**
+ * File>Record Session menu handler
+ * @param event Menu event
+ */
+void AquariumView::OnRecord(wxCommandEvent& event)
+{
+ wxFileDialog recordFileDialog(this, L"Record Session", L"", L"",
+         L"Session Files (*.aqsession)|*.aqsession", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+ if (recordFileDialog.ShowModal() == wxID_CANCEL)
+ {
+  return;
+ }
+
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::Record;
+ command.name = recordFileDialog.GetPath().ToStdWstring();
+ Send(std::move(command));
+}
+
+/**
+ * File>Stop Recording menu handler
+ * @param event Menu event
+ */
+void AquariumView::OnStopRecording(wxCommandEvent& event)
+{
+ AquariumCommand command;
+ command.type = AquariumCommand::Type::StopRecording;
+ Send(std::move(command));
+}
+
 /**
  * sets timer
  * @param event timer event
  */
 void AquariumView::OnTimer(wxTimerEvent& event)
 {
+ SendUnsent();
  Refresh();
+}
+
+/**
+ * Send a change to the simulation thread without waiting.
+ *
+ * If the queue is full, or earlier commands are still waiting
+ * for room, the command waits its turn here and goes out on a
+ * later timer tick.
+ *
+ * @param command The change to make
+ */
+void AquariumView::Send(AquariumCommand &&command)
+{
+ if (mUnsent.empty() && mAquarium.Send(std::move(command)))
+ {
+  return;
+ }
+
+ mUnsent.push_back(std::move(command));
+}
+
+/**
+ * Send as many waiting commands as the queue has room for
+ */
+void AquariumView::SendUnsent()
+{
+ while (!mUnsent.empty() && mAquarium.Send(std::move(mUnsent.front())))
+ {
+  mUnsent.pop_front();
+ }
 }
\ No newline at end of file
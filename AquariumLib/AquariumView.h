@@ -14,6 +14,10 @@
 #include "Aquarium.h"
 #include <algorithm>
 #include "MainFrame.h"
+#include "SimulationThread.h"
+#include "AquariumCommand.h"
+#include "StaticLayer.h"
+#include <deque>
 
 
 /**
@@ -39,11 +43,14 @@ private:
 
  void OnAddFishDoryFish(wxCommandEvent& event);
  void OnAddDecorCastle(wxCommandEvent& event);
+ void OnSchooling(wxCommandEvent& event);
 
 public:
 
  void Initialize(wxFrame* parent);
 
+ void StartSimulation();
+
 
  void OnLeftDown(wxMouseEvent &event);
 
@@ -53,25 +60,32 @@ public:
 
  void OnMouseMove(wxMouseEvent &event);
 
- /// item being moved with the mouse
- std::shared_ptr<Item> mGrabbedItem;
+ /// item being moved with the mouse, as named by the snapshot it was clicked in
+ ItemHandle mGrabbedItem;
 
 private:
  /// An object that describes our aquarium
  Aquarium mAquarium;
 
+ /// Thread that runs the simulation, stopped before the aquarium goes away
+ SimulationThread mSimulation{&mAquarium};
+
+ /// Background and decor drawn once and reused by OnPaint
+ StaticLayer mStaticLayer;
+
  void OnFileSaveAs(wxCommandEvent& event);
  void OnFileOpen(wxCommandEvent& event);
+ void OnRecord(wxCommandEvent& event);
+ void OnStopRecording(wxCommandEvent& event);
  void OnTimer(wxTimerEvent& event);
+ void Send(AquariumCommand &&command);
+ void SendUnsent();
 
  /// The timer that allows for animation
  wxTimer mTimer;
 
- /// Stopwatch used to measure elapsed time
- wxStopWatch mStopWatch;
-
- /// The last stopwatch time
- long mTime = 0;
+ /// Commands the queue had no room for, in order, sent again on the next tick
+ std::deque<AquariumCommand> mUnsent;
 };
 
 
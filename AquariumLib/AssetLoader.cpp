@@ -0,0 +1,144 @@
+/**
+ * @file AssetLoader.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the AssetLoader class.
+ */
+
+#include "pch.h"
+#include "AssetLoader.h"
+#include "SpriteCache.h"
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <algorithm>
+
+using namespace std;
+
+/// How many parent directories of the executable we look in for the images
+const int MaxRootSearchDepth = 4;
+
+/**
+ * Destructor, waits for the workers to finish
+ */
+AssetLoader::~AssetLoader()
+{
+ Wait();
+}
+
+/**
+ * Find the directory that holds an asset directory.
+ *
+ * Looks in the working directory first, then next to the executable
+ * and in its parents (which covers build trees and macOS bundles).
+ *
+ * @param directory Asset directory to look for, such as L"images"
+ * @return Directory holding it, or empty if only the working directory will do
+ */
+std::wstring AssetLoader::FindRoot(const std::wstring &directory)
+{
+ if (wxDirExists(directory))
+ {
+  return L"";
+ }
+
+ wxFileName path(wxStandardPaths::Get().GetExecutablePath());
+ for (int depth = 0; depth <= MaxRootSearchDepth && path.GetDirCount() > 0; depth++)
+ {
+  auto candidate = path.GetPath() + L"/" + directory;
+  if (wxDirExists(candidate))
+  {
+   return path.GetPath().ToStdWstring();
+  }
+
+  path.RemoveLastDir();
+ }
+
+ return L"";
+}
+
+/**
+ * Start decoding every PNG image in a directory.
+ *
+ * The images are registered with the SpriteCache as pending right
+ * away, so an item asking for one before it is done just waits for
+ * that one image rather than decoding it again.
+ *
+ * @param directory Directory relative to the cache root, such as L"images"
+ * @param done Called on a worker thread when the last image is decoded, may be empty
+ * @return Number of images being decoded
+ */
+int AssetLoader::Start(const std::wstring &directory, std::function<void()> done)
+{
+ auto &cache = SpriteCache::Instance();
+
+ wxDir dir(cache.ResolvePath(directory));
+ if (dir.IsOpened())
+ {
+  wxString name;
+  for (bool found = dir.GetFirst(&name, L"*.png", wxDIR_FILES); found; found = dir.GetNext(&name))
+  {
+   mFilenames.push_back(directory + L"/" + name.ToStdWstring());
+   mPaths.push_back(cache.ResolvePath(mFilenames.back()));
+  }
+ }
+
+ mDone = done;
+ mImages.resize(mFilenames.size());
+ mNext = 0;
+ mRemaining = mFilenames.size();
+
+ for (size_t i = 0; i < mFilenames.size(); i++)
+ {
+  cache.AddPending(mFilenames[i], mImages[i].get_future().share());
+ }
+
+ if (mFilenames.empty())
+ {
+  if (mDone)
+  {
+   mDone();
+  }
+  return 0;
+ }
+
+ size_t threads = max(1u, thread::hardware_concurrency());
+ threads = min(threads, mFilenames.size());
+ for (size_t i = 0; i < threads; i++)
+ {
+  mWorkers.emplace_back(&AssetLoader::Work, this);
+ }
+
+ return (int)mFilenames.size();
+}
+
+/**
+ * Worker thread body, decodes images until there are none left
+ */
+void AssetLoader::Work()
+{
+ for (auto i = mNext++; i < mFilenames.size(); i = mNext++)
+ {
+  // Only this thread touches the image until the promise hands it over.
+  // The path was resolved up front, the cache may be waiting on us holding its lock.
+  auto image = make_shared<wxImage>(mPaths[i], wxBITMAP_TYPE_ANY);
+  mImages[i].set_value(image);
+
+  if (--mRemaining == 0 && mDone)
+  {
+   mDone();
+  }
+ }
+}
+
+/**
+ * Wait for the workers to finish
+ */
+void AssetLoader::Wait()
+{
+ for (auto &worker : mWorkers)
+ {
+  worker.join();
+ }
+ mWorkers.clear();
+}
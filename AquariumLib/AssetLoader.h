@@ -0,0 +1,75 @@
+/**
+ * @file AssetLoader.h
+ * @author Yeji Lee
+ *
+ * Declaration of the AssetLoader class.
+ *
+ * Finds the images directory and decodes every image in it on a
+ * pool of worker threads, so the window can come up while the
+ * sprite cache fills in behind it.
+ */
+
+#ifndef AQUARIUM_ASSETLOADER_H
+#define AQUARIUM_ASSETLOADER_H
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Startup loader that decodes sprites in parallel.
+ *
+ * Only the decoding happens on the workers. The decoded images are
+ * handed to the SpriteCache as pending images, and the sprites (which
+ * own bitmaps) are created on the GUI thread, either when an item first
+ * asks for one or when SpriteCache::LoadPending() is called. The
+ * application shows its window right away and, when the done callback
+ * says the last image is decoded, calls LoadPending on the GUI thread
+ * and only then starts the simulation thread, which may not create sprites.
+ */
+class AssetLoader {
+private:
+ /// Image paths we are decoding, as the cache knows them
+ std::vector<std::wstring> mFilenames;
+
+ /// The same paths resolved against the cache root, for the workers to open
+ std::vector<std::wstring> mPaths;
+
+ /// One promise per image, fulfilled by a worker
+ std::vector<std::promise<std::shared_ptr<wxImage>>> mImages;
+
+ /// Index of the next image a worker should take
+ std::atomic<size_t> mNext{0};
+
+ /// Number of images not decoded yet
+ std::atomic<size_t> mRemaining{0};
+
+ /// Called on a worker thread once every image is decoded
+ std::function<void()> mDone;
+
+ /// The worker threads
+ std::vector<std::thread> mWorkers;
+
+ void Work();
+
+public:
+ AssetLoader() = default;
+ ~AssetLoader();
+
+ /// Copy constructor (disabled)
+ AssetLoader(const AssetLoader &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const AssetLoader &) = delete;
+
+ static std::wstring FindRoot(const std::wstring &directory);
+
+ int Start(const std::wstring &directory, std::function<void()> done);
+ void Wait();
+};
+
+#endif //AQUARIUM_ASSETLOADER_H
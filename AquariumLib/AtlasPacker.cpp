@@ -0,0 +1,87 @@
+/**
+ * @file AtlasPacker.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the AtlasPacker class.
+ */
+
+#include "pch.h"
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+/**
+ * Constructor
+ * @param maxWidth Widest the atlas may get in pixels
+ * @param padding Empty pixels to keep between rectangles
+ */
+AtlasPacker::AtlasPacker(int maxWidth, int padding) : mMaxWidth(maxWidth), mPadding(padding)
+{
+}
+
+/**
+ * Add a rectangle to be packed
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @return Index to get the placed rectangle with after packing
+ */
+int AtlasPacker::Add(int width, int height)
+{
+ AtlasRect rect;
+ rect.width = width;
+ rect.height = height;
+ mRects.push_back(rect);
+
+ return (int)mRects.size() - 1;
+}
+
+/**
+ * Place all of the rectangles
+ * @return false if some rectangle is wider than the atlas may be
+ */
+bool AtlasPacker::Pack()
+{
+ // Tallest first so each shelf wastes as little height as possible
+ vector<int> order(mRects.size());
+ iota(order.begin(), order.end(), 0);
+ stable_sort(order.begin(), order.end(), [this](int a, int b) {
+  return mRects[a].height > mRects[b].height;
+ });
+
+ int shelfX = mPadding;
+ int shelfY = mPadding;
+ int shelfHeight = 0;
+
+ mWidth = 0;
+ mHeight = 0;
+
+ for (auto index : order)
+ {
+  auto &rect = mRects[index];
+  if (rect.width + mPadding * 2 > mMaxWidth)
+  {
+   return false;
+  }
+
+  if (shelfX + rect.width + mPadding > mMaxWidth)
+  {
+   // This shelf is full, start a new one below it
+   shelfY += shelfHeight + mPadding;
+   shelfX = mPadding;
+   shelfHeight = 0;
+  }
+
+  rect.x = shelfX;
+  rect.y = shelfY;
+
+  shelfX += rect.width + mPadding;
+  shelfHeight = max(shelfHeight, rect.height);
+
+  mWidth = max(mWidth, shelfX);
+  mHeight = max(mHeight, shelfY + rect.height + mPadding);
+ }
+
+ return true;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file AtlasPacker.h
+ * @author Yeji Lee
+ *
+ * Declaration of the AtlasPacker class.
+ *
+ * Decides where each sprite goes in a sprite atlas. This only
+ * deals with rectangles, the SpriteAtlas does the pixel copying.
+ */
+
+#ifndef AQUARIUM_ATLASPACKER_H
+#define AQUARIUM_ATLASPACKER_H
+
+#include <vector>
+
+/**
+ * A placed rectangle in the atlas
+ */
+struct AtlasRect {
+ int x = 0;        ///< Left edge in pixels
+ int y = 0;        ///< Top edge in pixels
+ int width = 0;    ///< Width in pixels
+ int height = 0;   ///< Height in pixels
+};
+
+/**
+ * Shelf packer for sprite rectangles.
+ *
+ * Rectangles are sorted tallest first and laid out left to right
+ * in rows (shelves), starting a new shelf when a row is full. This
+ * is simple and packs sprites of similar height well, which is
+ * what our images are.
+ */
+class AtlasPacker {
+private:
+ /// Widest the atlas may get
+ int mMaxWidth;
+
+ /// Empty pixels kept between rectangles so sampling never bleeds
+ int mPadding;
+
+ /// The rectangles, in the order they were added
+ std::vector<AtlasRect> mRects;
+
+ /// Width of the packed atlas
+ int mWidth = 0;
+
+ /// Height of the packed atlas
+ int mHeight = 0;
+
+public:
+ AtlasPacker(int maxWidth, int padding);
+
+ int Add(int width, int height);
+ bool Pack();
+
+ /**
+  * Get a placed rectangle, valid after Pack()
+  * @param index Index returned by Add()
+  * @return The rectangle
+  */
+ const AtlasRect &GetRect(int index) const { return mRects[index]; }
+
+ /**
+  * Number of rectangles added
+  * @return Count
+  */
+ int GetCount() const { return (int)mRects.size(); }
+
+ /**
+  * Width of the packed atlas, valid after Pack()
+  * @return Width in pixels
+  */
+ int GetWidth() const { return mWidth; }
+
+ /**
+  * Height of the packed atlas, valid after Pack()
+  * @return Height in pixels
+  */
+ int GetHeight() const { return mHeight; }
+};
+
+#endif //AQUARIUM_ATLASPACKER_H
@@ -0,0 +1,65 @@
+/**
+ * @file CounterRandom.h
+ * @author Yeji Lee
+ *
+ * Declaration of the CounterRandom class.
+ *
+ * Random numbers computed from a stream key and a draw counter
+ * instead of generator state, so every fish can have its own
+ * stream that does not depend on which thread updates it.
+ */
+
+#ifndef AQUARIUM_COUNTERRANDOM_H
+#define AQUARIUM_COUNTERRANDOM_H
+
+#include <cstdint>
+
+/**
+ * Counter-based random number streams.
+ *
+ * The n-th number of a stream is a hash of the stream key and n.
+ * The hash is the SplitMix64 finalizer, which passes the usual
+ * statistical test suites and costs a handful of multiplies.
+ */
+class CounterRandom {
+private:
+ /// Odd constant from the golden ratio that spaces out counters
+ static const uint64_t Gamma = 0x9E3779B97F4A7C15ull;
+
+ /**
+  * Scramble a 64 bit value
+  * @param z Value to scramble
+  * @return Scrambled value
+  */
+ static uint64_t Mix(uint64_t z)
+ {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+ }
+
+public:
+ /**
+  * Get a number from a stream
+  * @param key Key of the stream
+  * @param counter Which number of the stream to get
+  * @return 64 random bits
+  */
+ static uint64_t Get(uint64_t key, uint64_t counter)
+ {
+  return Mix(key + (counter + 1) * Gamma);
+ }
+
+ /**
+  * Make the key for one of a set of streams
+  * @param seed Seed shared by the set of streams
+  * @param stream Number of the stream within the set
+  * @return Stream key
+  */
+ static uint64_t Key(uint64_t seed, uint64_t stream)
+ {
+  return Mix(Get(seed, stream));
+ }
+};
+
+#endif //AQUARIUM_COUNTERRANDOM_H
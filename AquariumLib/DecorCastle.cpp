@@ -22,20 +22,5 @@ const wstring DecorCastleImageName = L"images/castle.png";
  */
 DecorCastle::DecorCastle(Aquarium *aquarium) : Item(aquarium, DecorCastleImageName)
 {
+ SetType(Type);
 }
-
-/**
- * Save this fish to an XML node
- * @param node The parent node we are going to be a child of
- * @return
- */
-wxXmlNode* DecorCastle::XmlSave(wxXmlNode* node)
-{
- auto itemNode = Item::XmlSave(node);
-
- itemNode->AddAttribute(L"type", L"castle");
-
- return itemNode;
-
-
-}
\ No newline at end of file
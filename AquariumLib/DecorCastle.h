@@ -23,6 +23,9 @@ class DecorCastle : public Item {
 private:
 
 public:
+ /// Name a castle is saved under
+ static constexpr const wchar_t *Type = L"castle";
+
  /// Default constructor (disabled)
  DecorCastle() = delete;
 
@@ -34,7 +37,12 @@ public:
 
  /// for fish beta
  DecorCastle(Aquarium* aquarium);
- wxXmlNode* XmlSave(wxXmlNode* node) override;
+
+ /**
+  * A castle never moves by itself
+  * @return true
+  */
+ bool IsStatic() const override { return true; }
 };
 
 #endif //DECORCASTLE_H
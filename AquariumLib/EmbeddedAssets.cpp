@@ -0,0 +1,60 @@
+/**
+ * @file EmbeddedAssets.cpp
+ * @author Yeji Lee
+ *
+ * Lookup of the images compiled into the library.
+ */
+
+#include "pch.h"
+#include "EmbeddedAssets.h"
+
+#ifdef AQUARIUM_EMBED_ASSETS
+// Generated by the EmbedAssets tool, defines EmbeddedAssetTable
+#include "EmbeddedAssetData.inc"
+
+/// Number of entries in EmbeddedAssetTable
+static const size_t EmbeddedAssetTableSize = sizeof(EmbeddedAssetTable) / sizeof(EmbeddedAssetTable[0]);
+#else
+/// No images are embedded in this build
+static const EmbeddedAsset *const EmbeddedAssetTable = nullptr;
+
+/// Number of entries in EmbeddedAssetTable
+static const size_t EmbeddedAssetTableSize = 0;
+#endif
+
+/**
+ * Number of images compiled into the library
+ * @return Count, 0 unless built with AQUARIUM_EMBED_ASSETS
+ */
+size_t GetEmbeddedAssetCount()
+{
+ return EmbeddedAssetTableSize;
+}
+
+/**
+ * Get an embedded image by index
+ * @param index Index less than GetEmbeddedAssetCount()
+ * @return The image
+ */
+const EmbeddedAsset *GetEmbeddedAsset(size_t index)
+{
+ return &EmbeddedAssetTable[index];
+}
+
+/**
+ * Find an embedded image by the path it is requested by
+ * @param name Path like L"images/beta.png"
+ * @return The image or nullptr if it is not embedded
+ */
+const EmbeddedAsset *FindEmbeddedAsset(const std::wstring &name)
+{
+ for (size_t i = 0; i < EmbeddedAssetTableSize; i++)
+ {
+  if (name == EmbeddedAssetTable[i].name)
+  {
+   return &EmbeddedAssetTable[i];
+  }
+ }
+
+ return nullptr;
+}
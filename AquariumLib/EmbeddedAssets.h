@@ -0,0 +1,37 @@
+/**
+ * @file EmbeddedAssets.h
+ * @author Yeji Lee
+ *
+ * Images compiled into the library as decoded pixel data.
+ *
+ * When AquariumLib is built with AQUARIUM_EMBED_ASSETS the EmbedAssets
+ * tool decodes every image at build time and the pixels are compiled in,
+ * so the sprite cache can create sprites without opening or decoding
+ * any files. Without the option there are no embedded assets.
+ */
+
+#ifndef AQUARIUM_EMBEDDEDASSETS_H
+#define AQUARIUM_EMBEDDEDASSETS_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * One decoded image compiled into the library.
+ *
+ * The pixels are stored the way wxImage keeps them, an RGB plane
+ * and an alpha plane, so an image can use them without copying.
+ */
+struct EmbeddedAsset {
+ const wchar_t *name;          ///< Path the image is requested by, like L"images/beta.png"
+ int width;                    ///< Width in pixels
+ int height;                   ///< Height in pixels
+ const unsigned char *rgb;     ///< width * height * 3 bytes of RGB
+ const unsigned char *alpha;   ///< width * height bytes of alpha, or nullptr
+};
+
+size_t GetEmbeddedAssetCount();
+const EmbeddedAsset *GetEmbeddedAsset(size_t index);
+const EmbeddedAsset *FindEmbeddedAsset(const std::wstring &name);
+
+#endif //AQUARIUM_EMBEDDEDASSETS_H
@@ -8,6 +8,7 @@
 #include"Aquarium.h"
 #include <random>
 #include "Item.h"
+#include "Sprite.h"
 
 /// Maximum speed in the X direction in
 /// in pixels per second
@@ -18,78 +19,61 @@ const double MaxSpeedX = 50;
 const double MinSpeedX = 20;
 
 
+/**
+ * Constructor, makes the fish's entity with a Velocity,
+ * Jitter and School and gives it a random speed
+ * @param aquarium The aquarium this fish belongs to
+ * @param filename The image file name representing the fish
+ */
 Fish::Fish(Aquarium *aquarium, const std::wstring &filename) :
-    Item(aquarium, filename)
+    Item(aquarium, filename, Component::Fish)
 {
     std::uniform_real_distribution<double> distribution(MinSpeedX, MaxSpeedX);
-    mSpeedX = distribution(aquarium->GetRandom());
-    mSpeedY = 0;
+    SetSpeed(distribution(aquarium->GetRandom()), 0);
 }
 
-
-void Fish::Update(double elapsed)
+/**
+ * speed of the fish in both x and y coordinate
+ * @param speedX speed in x coordinate in pixels
+ * @param speedY speed in y coordinate in pixel
+ */
+void Fish::SetSpeed(double speedX, double speedY)
 {
-    SetLocation(GetX() + mSpeedX * elapsed, // speed of x coordinnate
-            GetY() + mSpeedY * elapsed); // speed of y coordinate
-
-    double halfWidth = mItemBitmap->GetWidth() / 2;
-    double halfHeight = mItemBitmap->GetHeight() / 2;
-
-    if (GetX() >= GetAquarium()->GetWidth() - halfWidth && mSpeedX > 0)
-    {
-        // If hitting the right boundary, reverse direction
-        mSpeedX = -mSpeedX;
-        SetMirror(true); // Mirror when changing to left direction
-    }
-    else if (GetX() <= halfWidth && mSpeedX < 0)
-    {
-        // If hitting the left boundary, reverse direction
-        mSpeedX = -mSpeedX;
-        SetMirror(false); // Un-mirror when changing to right direction
-    }
-
-    if (GetY() <= 10 + halfHeight || GetY() >= GetAquarium()->GetHeight() - 10 - halfHeight)
-    {
-        mSpeedY = -mSpeedY; // Reverse vertical direction
-        // No mirroring change needed for vertical movement
-    }
-    static double time = 0;
-    time += elapsed;
-
-    // Change vertical direction every 1 second
-    if (time > 1.0)
-    {
-        time = 0; // Reset the timer
-        mSpeedY += (GetAquarium()->GetRandom()() % 2 == 0 ? 5 : -5);
-    }
+    GetWorld().SetSpeed(GetEntity(), speedX, speedY);
 }
 
-
-wxXmlNode* Fish::XmlSave(wxXmlNode* node) {
-    // Save position and speed
-    auto itemNode = Item::XmlSave(node);
-    itemNode->AddAttribute(L"speedx", wxString::Format(L"%g", mSpeedX));
-    itemNode->AddAttribute(L"speedy", wxString::Format(L"%g", mSpeedY));
-    return itemNode;
+/**
+ * Set which species this fish is, and so which fish it schools with
+ * @param species The species
+ */
+void Fish::SetSpecies(FishSpecies species)
+{
+    GetWorld().SetSpecies(GetEntity(), species);
 }
 
 /**
- * load the fish state from an XML node
- * retrives the fish position and speed information from the node's attribute
- * @param node the XML node from which this fish data will be loaded
+ * get current speed of the fish in x coordinate
+ * @return speed in x coordinate in pixels
  */
-void Fish::XmlLoad(wxXmlNode* node) {
-    // Load position and speed
-    Item::XmlLoad(node);
-    node->GetAttribute(L"speedx").ToDouble(&mSpeedX);
-    node->GetAttribute(L"speedy").ToDouble(&mSpeedY);
+double Fish::GetSpeedX() const
+{
+    return GetWorld().GetSpeedX(GetEntity());
 }
 
+/**
+ * get current speed of the fish in y coordinate
+ * @return speed in y coordinate in pixels
+ */
+double Fish::GetSpeedY() const
+{
+    return GetWorld().GetSpeedY(GetEntity());
+}
 
 void Fish::SetRandomSpeed(double minX, double maxX, double minY, double maxY) {
     std::uniform_real_distribution<> distX(minX, maxX);
     std::uniform_real_distribution<> distY(minY, maxY);
 
-    mSpeedX = distX(GetAquarium()->GetRandom());
-    mSpeedY = distY(GetAquarium()->GetRandom());
+    double speedX = distX(GetAquarium()->GetRandom());
+    double speedY = distY(GetAquarium()->GetRandom());
+    SetSpeed(speedX, speedY);
 }
\ No newline at end of file
@@ -9,24 +9,18 @@
 #define FISH_H
 
 #include "Item.h"
+#include "Schooling.h"
 
 /**
  * Base class for a fish
  * This applies to all of the fish, but not the decor
  * items in the aquarium.
+ *
+ * A fish's entity has a Velocity, Jitter and School as well as
+ * what every item has, so the world's systems move it.
  */
 class Fish : public Item {
 private:
- /**
-  * speed of x coordinate
-  */
- double mSpeedX = 0;;
-
- /**
-  * speed of y coordinate
-  */
- double mSpeedY= 0;;
-
 
 protected:
  /**
@@ -36,11 +30,6 @@ protected:
   */
  Fish(Aquarium* aquarium, const std::wstring& filename);
 
- /**
-  * background member
-  */
- std::unique_ptr<wxBitmap> mBackground;
-
  /**
   *set random speed for fish within the specified range
   *
@@ -51,6 +40,8 @@ protected:
   */
  void SetRandomSpeed(double minX, double maxX, double minY, double maxY);
 
+ void SetSpecies(FishSpecies species);
+
 
 
 public:
@@ -63,40 +54,10 @@ public:
 
  void operator=(const Fish &) = delete;
 
- /**
-  * updates the fish poisition based on the elapsed time
-  * called to update fish movement in aquairum
-  * @param elapsed the time since the last update in seconds
-  */
- void Update(double elapsed)override;
-
- /**
-  * speed of the fish in both x and y coordinate
-  * @param speedX speed in x coordinate in pixels
-  * @param speedY speed in y coordinate in pixel
-  */
- void SetSpeed(double speedX, double speedY){mSpeedX = speedX; mSpeedY = speedY;}
-
- /**
-  *
-  * @param node the [parent xml node to which this fish data will be saved
-  * @return a pointer to the new XML node created for this fish
-  */
- wxXmlNode* XmlSave(wxXmlNode* node) override;
+ void SetSpeed(double speedX, double speedY);
 
- void XmlLoad(wxXmlNode* node);
-
- /**
-  * get current speed of the fish in x coordinate
-  * @return speed in x coordinate in pixels
-  */
- double GetSpeedX(){return mSpeedX;}
-
- /**
-  * get current speed of the fish in y coordinate
-  * @return speed in y coordinate in pixels
-  */
- double GetSpeedY(){return mSpeedY;}
+ double GetSpeedX() const;
+ double GetSpeedY() const;
 
 
 };
@@ -4,46 +4,28 @@
  *
  * declaration of fishbeta class
  *
- * contains declaration of class fishbeta, representing beta fish.
- *
- * handles drawinf and interaction of the beta fish
+ * contains the traits of the beta species and the fish type made from them
  */
  
 #ifndef AQUARIUM_FISHBETA_H
 #define AQUARIUM_FISHBETA_H
 
-#include "Fish.h"
+#include "SpeciesFish.h"
 
 /**
- * FishBeta
- *
- * class representing beta fish
- *
- * inherit from Item class
- *
- * provides functionality for drawing and hit test (click)a beta fish
+ * Traits of the beta species
  */
-class FishBeta : public Fish {
-private:
-
-public:
- /// Default constructor (disabled)
- FishBeta() = delete;
-
- /// Copy constructor (disabled)
- FishBeta(const FishBeta &) = delete;
-
- /// Assignment operator
- void operator=(const FishBeta &) = delete;
-
- /// for fish beta
- FishBeta(Aquarium* aquarium);
- wxXmlNode* XmlSave(wxXmlNode* node) override;
- /**
-  * 
-  * @param node node for xml
-  */
- void XmlLoad(wxXmlNode* node);
+template <>
+struct SpeciesTraits<FishSpecies::Beta> {
+ static constexpr const wchar_t *Type = L"beta";             ///< Name it is saved under
+ static constexpr const wchar_t *Image = L"images/beta.png"; ///< Sprite it is drawn with
+ static constexpr double MinSpeedX = 70;                     ///< Slowest starting X speed
+ static constexpr double MaxSpeedX = 100;                    ///< Fastest starting X speed
+ static constexpr double MinSpeedY = 70;                     ///< Slowest starting Y speed
+ static constexpr double MaxSpeedY = 100;                    ///< Fastest starting Y speed
 };
 
-#endif //AQUARIUM_FISHBETA_H
\ No newline at end of file
+/// A beta fish
+typedef SpeciesFish<FishSpecies::Beta> FishBeta;
+
+#endif //AQUARIUM_FISHBETA_H
@@ -4,45 +4,30 @@
  *
  * declaration of the fishdory class
  *
- * contain declaration of the fish dory class
+ * contains the traits of the dory species and the fish type made from them
  *
  * represents dory fish in aquarium
- *
- * provides functionality for drawing and interaction
  */
  
 #ifndef FISHDORY_H
 #define FISHDORY_H
 
-
-
-#include "Fish.h"
+#include "SpeciesFish.h"
 
 /**
- * Class for a fish of type Dory
- *
- * inherits from Item class
- *
- * provides functionality for drawinf and clicking dory fish
+ * Traits of the dory species
  */
-class FishDory : public Fish {
-private:
-
-public:
- /// Default constructor (disabled)
- FishDory() = delete;
-
- /// Copy constructor (disabled)
- FishDory(const FishDory &) = delete;
-
- /// Assignment operator
- void operator=(const FishDory &) = delete;
-
-
- FishDory(Aquarium* aquarium);
- wxXmlNode* XmlSave(wxXmlNode* node) override;
+template <>
+struct SpeciesTraits<FishSpecies::Dory> {
+ static constexpr const wchar_t *Type = L"dory";             ///< Name it is saved under
+ static constexpr const wchar_t *Image = L"images/dory.png"; ///< Sprite it is drawn with
+ static constexpr double MinSpeedX = 150;                    ///< Slowest starting X speed
+ static constexpr double MaxSpeedX = 200;                    ///< Fastest starting X speed
+ static constexpr double MinSpeedY = 150;                    ///< Slowest starting Y speed
+ static constexpr double MaxSpeedY = 200;                    ///< Fastest starting Y speed
 };
 
-
+/// A dory fish
+typedef SpeciesFish<FishSpecies::Dory> FishDory;
 
 #endif //FISHDORY_H
@@ -0,0 +1,322 @@
+/**
+ * @file FishKernel.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the FishKernel class.
+ *
+ * The vector versions do the same operations in the same order as
+ * the scalar one, with masks in place of branches. This file is
+ * built without multiply-add contraction (see CMakeLists.txt), so
+ * the results match bit for bit. Speeds are negated by flipping
+ * the sign bit, which is what the scalar negation does too.
+ */
+
+#include "pch.h"
+#include "FishKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AQUARIUM_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(AQUARIUM_X86) && (defined(__GNUC__) || defined(__clang__))
+/// Compile one function for an instruction set the rest of the build does not assume
+#define AQUARIUM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define AQUARIUM_TARGET(isa)
+#endif
+
+/// Space kept clear above and below the fish in pixels
+const double VerticalMargin = 10;
+
+/**
+ * Move and bounce fish one at a time
+ * @param batch The fish to move
+ * @param first Index of the first fish to move
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+static void MoveScalar(const FishBatch &batch, size_t first, double elapsed, double width, double height)
+{
+ auto x = batch.x;
+ auto y = batch.y;
+ auto speedX = batch.speedX;
+ auto speedY = batch.speedY;
+ auto halfWidth = batch.halfWidth;
+ auto halfHeight = batch.halfHeight;
+ auto mirror = batch.mirror;
+
+ for (size_t i = first; i < batch.count; i++)
+ {
+  x[i] += speedX[i] * elapsed;
+  y[i] += speedY[i] * elapsed;
+
+  if (x[i] >= width - halfWidth[i] && speedX[i] > 0)
+  {
+   // Hitting the right wall, turn and face left
+   speedX[i] = -speedX[i];
+   mirror[i] = 1;
+  }
+  else if (x[i] <= halfWidth[i] && speedX[i] < 0)
+  {
+   // Hitting the left wall, turn and face right
+   speedX[i] = -speedX[i];
+   mirror[i] = 0;
+  }
+
+  if (y[i] <= VerticalMargin + halfHeight[i] || y[i] >= height - VerticalMargin - halfHeight[i])
+  {
+   speedY[i] = -speedY[i];
+  }
+ }
+}
+
+#ifdef AQUARIUM_X86
+
+/**
+ * Set the mirror flags of fish that turned around
+ * @param mirror Mirror flags of the group of fish
+ * @param right Bit per fish that hit the right wall
+ * @param left Bit per fish that hit the left wall
+ * @param lanes Number of fish in the group
+ */
+static inline void SetMirrors(uint8_t *mirror, int right, int left, int lanes)
+{
+ for (int k = 0; k < lanes; k++)
+ {
+  if (right & (1 << k))
+  {
+   mirror[k] = 1;
+  }
+  else if (left & (1 << k))
+  {
+   mirror[k] = 0;
+  }
+ }
+}
+
+/**
+ * Move and bounce fish two at a time with SSE2
+ * @param batch The fish to move
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+AQUARIUM_TARGET("sse2")
+static void MoveSSE2(const FishBatch &batch, double elapsed, double width, double height)
+{
+ const __m128d dt = _mm_set1_pd(elapsed);
+ const __m128d right = _mm_set1_pd(width);
+ const __m128d top = _mm_set1_pd(VerticalMargin);
+ const __m128d bottom = _mm_set1_pd(height - VerticalMargin);
+ const __m128d zero = _mm_setzero_pd();
+ const __m128d sign = _mm_set1_pd(-0.0);
+
+ size_t i = 0;
+ for (; i + 2 <= batch.count; i += 2)
+ {
+  __m128d speedX = _mm_loadu_pd(batch.speedX + i);
+  __m128d speedY = _mm_loadu_pd(batch.speedY + i);
+  __m128d x = _mm_add_pd(_mm_loadu_pd(batch.x + i), _mm_mul_pd(speedX, dt));
+  __m128d y = _mm_add_pd(_mm_loadu_pd(batch.y + i), _mm_mul_pd(speedY, dt));
+  __m128d halfWidth = _mm_loadu_pd(batch.halfWidth + i);
+  __m128d halfHeight = _mm_loadu_pd(batch.halfHeight + i);
+
+  __m128d hitRight = _mm_and_pd(_mm_cmpge_pd(x, _mm_sub_pd(right, halfWidth)), _mm_cmpgt_pd(speedX, zero));
+  __m128d hitLeft = _mm_and_pd(_mm_cmple_pd(x, halfWidth), _mm_cmplt_pd(speedX, zero));
+  speedX = _mm_xor_pd(speedX, _mm_and_pd(_mm_or_pd(hitRight, hitLeft), sign));
+
+  __m128d hitY = _mm_or_pd(_mm_cmple_pd(y, _mm_add_pd(top, halfHeight)),
+          _mm_cmpge_pd(y, _mm_sub_pd(bottom, halfHeight)));
+  speedY = _mm_xor_pd(speedY, _mm_and_pd(hitY, sign));
+
+  _mm_storeu_pd(batch.x + i, x);
+  _mm_storeu_pd(batch.y + i, y);
+  _mm_storeu_pd(batch.speedX + i, speedX);
+  _mm_storeu_pd(batch.speedY + i, speedY);
+
+  SetMirrors(batch.mirror + i, _mm_movemask_pd(hitRight), _mm_movemask_pd(hitLeft), 2);
+ }
+
+ MoveScalar(batch, i, elapsed, width, height);
+}
+
+/**
+ * Move and bounce fish four at a time with AVX2
+ * @param batch The fish to move
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+AQUARIUM_TARGET("avx2")
+static void MoveAVX2(const FishBatch &batch, double elapsed, double width, double height)
+{
+ const __m256d dt = _mm256_set1_pd(elapsed);
+ const __m256d right = _mm256_set1_pd(width);
+ const __m256d top = _mm256_set1_pd(VerticalMargin);
+ const __m256d bottom = _mm256_set1_pd(height - VerticalMargin);
+ const __m256d zero = _mm256_setzero_pd();
+ const __m256d sign = _mm256_set1_pd(-0.0);
+
+ size_t i = 0;
+ for (; i + 4 <= batch.count; i += 4)
+ {
+  __m256d speedX = _mm256_loadu_pd(batch.speedX + i);
+  __m256d speedY = _mm256_loadu_pd(batch.speedY + i);
+  __m256d x = _mm256_add_pd(_mm256_loadu_pd(batch.x + i), _mm256_mul_pd(speedX, dt));
+  __m256d y = _mm256_add_pd(_mm256_loadu_pd(batch.y + i), _mm256_mul_pd(speedY, dt));
+  __m256d halfWidth = _mm256_loadu_pd(batch.halfWidth + i);
+  __m256d halfHeight = _mm256_loadu_pd(batch.halfHeight + i);
+
+  __m256d hitRight = _mm256_and_pd(_mm256_cmp_pd(x, _mm256_sub_pd(right, halfWidth), _CMP_GE_OQ),
+          _mm256_cmp_pd(speedX, zero, _CMP_GT_OQ));
+  __m256d hitLeft = _mm256_and_pd(_mm256_cmp_pd(x, halfWidth, _CMP_LE_OQ),
+          _mm256_cmp_pd(speedX, zero, _CMP_LT_OQ));
+  speedX = _mm256_xor_pd(speedX, _mm256_and_pd(_mm256_or_pd(hitRight, hitLeft), sign));
+
+  __m256d hitY = _mm256_or_pd(_mm256_cmp_pd(y, _mm256_add_pd(top, halfHeight), _CMP_LE_OQ),
+          _mm256_cmp_pd(y, _mm256_sub_pd(bottom, halfHeight), _CMP_GE_OQ));
+  speedY = _mm256_xor_pd(speedY, _mm256_and_pd(hitY, sign));
+
+  _mm256_storeu_pd(batch.x + i, x);
+  _mm256_storeu_pd(batch.y + i, y);
+  _mm256_storeu_pd(batch.speedX + i, speedX);
+  _mm256_storeu_pd(batch.speedY + i, speedY);
+
+  SetMirrors(batch.mirror + i, _mm256_movemask_pd(hitRight), _mm256_movemask_pd(hitLeft), 4);
+ }
+
+ MoveScalar(batch, i, elapsed, width, height);
+}
+
+/**
+ * Ask the processor whether it can run AVX2 code
+ * @return true if AVX2 is available and the OS saves the registers
+ */
+static bool DetectAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+ int info[4];
+ __cpuid(info, 0);
+ if (info[0] < 7)
+ {
+  return false;
+ }
+
+ // The OS has to save the upper halves of the registers too
+ __cpuid(info, 1);
+ bool osxsave = (info[2] & (1 << 27)) != 0;
+ bool avx = (info[2] & (1 << 28)) != 0;
+ if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+ {
+  return false;
+ }
+
+ __cpuidex(info, 7, 0);
+ return (info[1] & (1 << 5)) != 0;
+#else
+ __builtin_cpu_init();
+ return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // AQUARIUM_X86
+
+/**
+ * Can this processor run a kernel?
+ * @param level Instruction set of the kernel
+ * @return true if it can
+ */
+bool FishKernel::IsSupported(Level level)
+{
+ switch (level)
+ {
+ case Level::Scalar:
+  return true;
+
+#ifdef AQUARIUM_X86
+ case Level::SSE2:
+#if defined(__x86_64__) || defined(_M_X64)
+  // Every 64 bit x86 processor has SSE2
+  return true;
+#else
+  // Only trust it on 32 bit processors new enough for AVX2
+  return IsSupported(Level::AVX2);
+#endif
+
+ case Level::AVX2:
+ {
+  static const bool avx2 = DetectAVX2();
+  return avx2;
+ }
+#endif
+
+ default:
+  return false;
+ }
+}
+
+/**
+ * The widest kernel this processor can run, found once
+ * @return Kernel level
+ */
+FishKernel::Level FishKernel::GetBestLevel()
+{
+ static const Level best = IsSupported(Level::AVX2) ? Level::AVX2 :
+         IsSupported(Level::SSE2) ? Level::SSE2 : Level::Scalar;
+ return best;
+}
+
+/**
+ * Name of a kernel for reports
+ * @param level Kernel level
+ * @return Name of the instruction set
+ */
+const char *FishKernel::GetName(Level level)
+{
+ switch (level)
+ {
+ case Level::SSE2:
+  return "SSE2";
+
+ case Level::AVX2:
+  return "AVX2";
+
+ default:
+  return "scalar";
+ }
+}
+
+/**
+ * Move every fish in a batch and bounce them off the walls.
+ *
+ * A level the processor cannot run falls back to the scalar kernel.
+ *
+ * @param level Kernel to use
+ * @param batch The fish to move
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+void FishKernel::Move(Level level, const FishBatch &batch, double elapsed, double width, double height)
+{
+#ifdef AQUARIUM_X86
+ if (level == Level::AVX2 && IsSupported(Level::AVX2))
+ {
+  MoveAVX2(batch, elapsed, width, height);
+  return;
+ }
+
+ if (level != Level::Scalar && IsSupported(Level::SSE2))
+ {
+  MoveSSE2(batch, elapsed, width, height);
+  return;
+ }
+#endif
+
+ MoveScalar(batch, 0, elapsed, width, height);
+}
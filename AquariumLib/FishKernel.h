@@ -0,0 +1,62 @@
+/**
+ * @file FishKernel.h
+ * @author Yeji Lee
+ *
+ * Declaration of the FishKernel class.
+ *
+ * The loop that moves fish and bounces them off the walls, in a
+ * scalar version and SSE2 and AVX2 versions that do several fish
+ * at once. Every version gives exactly the same results.
+ */
+
+#ifndef AQUARIUM_FISHKERNEL_H
+#define AQUARIUM_FISHKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Pointers to the fish arrays a kernel works on, one entry per fish
+ */
+struct FishBatch {
+ double *x = nullptr;                    ///< X location of the fish center
+ double *y = nullptr;                    ///< Y location of the fish center
+ double *speedX = nullptr;               ///< X speed in pixels per second
+ double *speedY = nullptr;               ///< Y speed in pixels per second
+ const double *halfWidth = nullptr;      ///< Half the sprite width
+ const double *halfHeight = nullptr;     ///< Half the sprite height
+ uint8_t *mirror = nullptr;              ///< Nonzero if drawn mirrored
+ size_t count = 0;                       ///< Number of fish
+};
+
+/**
+ * Fish integration and wall reflection.
+ *
+ * Move picks the widest instruction set the processor supports
+ * the first time it is asked, so one build runs everywhere.
+ */
+class FishKernel {
+public:
+ /// Instruction sets a kernel can be written for
+ enum class Level {Scalar, SSE2, AVX2};
+
+ static Level GetBestLevel();
+ static bool IsSupported(Level level);
+ static const char *GetName(Level level);
+
+ static void Move(Level level, const FishBatch &batch, double elapsed, double width, double height);
+
+ /**
+  * Move fish with the best kernel for this processor
+  * @param batch The fish to move
+  * @param elapsed Time since the last update in seconds
+  * @param width Width of the aquarium in pixels
+  * @param height Height of the aquarium in pixels
+  */
+ static void Move(const FishBatch &batch, double elapsed, double width, double height)
+ {
+  Move(GetBestLevel(), batch, elapsed, width, height);
+ }
+};
+
+#endif //AQUARIUM_FISHKERNEL_H
@@ -4,37 +4,28 @@
  *
  * declaration of fish nemo class
  *
- * contains declaration of fish nemo class, representing a nemo fish
+ * contains the traits of the nemo species and the fish type made from them
  */
  
 #ifndef FISHNEMO_H
 #define FISHNEMO_H
 
-
-
-#include "Fish.h"
+#include "SpeciesFish.h"
 
 /**
- * Class for a fish of type Nemo
+ * Traits of the nemo species
  */
-class FishNemo : public Fish {
-private:
-
-public:
- /// Default constructor (disabled)
- FishNemo() = delete;
-
- /// Copy constructor (disabled)
- FishNemo(const FishNemo &) = delete;
-
- /// Assignment operator
- void operator=(const FishNemo &) = delete;
-
-
- FishNemo(Aquarium* aquarium);
- wxXmlNode* XmlSave(wxXmlNode* node) override;
+template <>
+struct SpeciesTraits<FishSpecies::Nemo> {
+ static constexpr const wchar_t *Type = L"nemo";             ///< Name it is saved under
+ static constexpr const wchar_t *Image = L"images/nemo.png"; ///< Sprite it is drawn with
+ static constexpr double MinSpeedX = 20;                     ///< Slowest starting X speed
+ static constexpr double MaxSpeedX = 35;                     ///< Fastest starting X speed
+ static constexpr double MinSpeedY = -10;                    ///< Slowest starting Y speed
+ static constexpr double MaxSpeedY = 10;                     ///< Fastest starting Y speed
 };
 
-
+/// A nemo fish
+typedef SpeciesFish<FishSpecies::Nemo> FishNemo;
 
 #endif //FISHNEMO_H
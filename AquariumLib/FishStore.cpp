@@ -0,0 +1,78 @@
+/**
+ * @file FishStore.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the FishStore class.
+ */
+
+#include "pch.h"
+#include "FishStore.h"
+
+using namespace std;
+
+/**
+ * Constructor, for a store with a world of its own
+ */
+FishStore::FishStore() : mWorld(make_shared<ItemWorld>())
+{
+}
+
+/**
+ * Constructor
+ * @param world World whose fish to view
+ */
+FishStore::FishStore(std::shared_ptr<ItemWorld> world) : mWorld(std::move(world))
+{
+}
+
+/**
+ * Add a fish to the store at the origin, not moving
+ * @param halfWidth Half the width of the fish sprite
+ * @param halfHeight Half the height of the fish sprite
+ * @return Slot of the new fish
+ */
+int FishStore::Add(double halfWidth, double halfHeight)
+{
+ auto slot = mWorld->Create(Component::Fish);
+ mWorld->SetHalfSize(slot, halfWidth, halfHeight);
+ return (int)slot;
+}
+
+/**
+ * Remove a fish from the store
+ * @param slot Slot of the fish to remove
+ */
+void FishStore::Remove(int slot)
+{
+ mWorld->Destroy(slot);
+}
+
+/**
+ * Make room for a number of fish without reallocating
+ * @param count Total number of fish to make room for
+ */
+void FishStore::Reserve(size_t count)
+{
+ mWorld->Reserve(Component::Fish, count);
+}
+
+/**
+ * Move every fish and bounce them off the walls.
+ *
+ * This runs every system of the world (see ItemWorld::Update):
+ * schooling when it is on, then moving, then jitter. Moving and
+ * jitter only read and write each fish's own slot, random stream
+ * included. Schooling reads the neighbours' positions and speeds
+ * but writes the speeds it steers to into separate arrays, so no
+ * fish sees another's new speed mid step. Either way the result is
+ * the same bit for bit however many threads there are.
+ *
+ * @param elapsed Time each step simulates in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ * @param steps Number of steps, batched where the systems allow
+ */
+void FishStore::Update(double elapsed, double width, double height, int steps)
+{
+ mWorld->Update(elapsed, width, height, steps);
+}
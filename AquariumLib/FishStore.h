@@ -0,0 +1,186 @@
+/**
+ * @file FishStore.h
+ * @author Yeji Lee
+ *
+ * Declaration of the FishStore class.
+ *
+ * The fish of an ItemWorld seen as numbered slots, for code that
+ * only cares about the moving state of fish.
+ */
+
+#ifndef AQUARIUM_FISHSTORE_H
+#define AQUARIUM_FISHSTORE_H
+
+#include <cstdint>
+#include <memory>
+#include "ItemWorld.h"
+
+class WorkerPool;
+
+/**
+ * View of the fish in an ItemWorld by slot.
+ *
+ * A slot is the fish's entity, so it stays the same for as long
+ * as the fish lives. The positions, speeds, half extents, mirror
+ * flags, jitter timers and random streams are components in the
+ * world, kept in parallel arrays and moved by its systems.
+ */
+class FishStore {
+private:
+ /// World holding the fish, shared with the aquarium and its items
+ std::shared_ptr<ItemWorld> mWorld;
+
+public:
+ FishStore();
+ explicit FishStore(std::shared_ptr<ItemWorld> world);
+
+ int Add(double halfWidth, double halfHeight);
+ void Remove(int slot);
+ void Reserve(size_t count);
+
+ void Update(double elapsed, double width, double height, int steps = 1);
+
+ /**
+  * Get the world the fish are in
+  * @return Reference to the world
+  */
+ ItemWorld &GetWorld() { return *mWorld; }
+
+ /**
+  * Set the seed for the random streams of fish added from now on
+  * @param seed Seed value
+  */
+ void SetSeed(uint64_t seed) { mWorld->SetSeed(seed); }
+
+ /**
+  * Choose the kernel that moves the fish, for comparing them
+  * @param kernel Kernel level, falls back to scalar if unsupported
+  */
+ void SetKernel(FishKernel::Level kernel) { mWorld->SetKernel(kernel); }
+
+ /**
+  * Choose the threads that move the fish
+  * @param pool Worker pool to use, the process-wide one by default
+  */
+ void SetWorkerPool(WorkerPool *pool) { mWorld->SetWorkerPool(pool); }
+
+ /**
+  * Get the schooling settings
+  * @return Reference to the schooling settings, off unless enabled
+  */
+ Schooling &GetSchooling() { return mWorld->GetSchooling(); }
+
+ /**
+  * Number of fish in the store
+  * @return Number of entities with a Velocity
+  */
+ size_t GetCount() const { return mWorld->GetCount(Component::Velocity); }
+
+ /**
+  * X location of a fish
+  * @param slot Slot of the fish
+  * @return X location of the fish center in pixels
+  */
+ double GetX(int slot) const { return mWorld->GetX(slot); }
+
+ /**
+  * Y location of a fish
+  * @param slot Slot of the fish
+  * @return Y location of the fish center in pixels
+  */
+ double GetY(int slot) const { return mWorld->GetY(slot); }
+
+ /**
+  * Set the location of a fish, with no interpolation from where it was
+  * @param slot Slot of the fish
+  * @param x X location in pixels
+  * @param y Y location in pixels
+  */
+ void SetLocation(int slot, double x, double y) { mWorld->SetLocation(slot, x, y); }
+
+ /**
+  * X location of a fish before the last update
+  * @param slot Slot of the fish
+  * @return X location in pixels
+  */
+ double GetPrevX(int slot) const { return mWorld->GetPrevX(slot); }
+
+ /**
+  * Y location of a fish before the last update
+  * @param slot Slot of the fish
+  * @return Y location in pixels
+  */
+ double GetPrevY(int slot) const { return mWorld->GetPrevY(slot); }
+
+ /**
+  * Set how far between the last two updates fish are drawn
+  * @param alpha 0 for the previous locations, 1 for the current ones
+  */
+ void SetInterpolation(double alpha) { mWorld->SetInterpolation(alpha); }
+
+ /**
+  * X location to draw a fish at
+  * @param slot Slot of the fish
+  * @return X location in pixels, between the last two updates
+  */
+ double GetDrawX(int slot) const { return mWorld->GetDrawX(slot); }
+
+ /**
+  * Y location to draw a fish at
+  * @param slot Slot of the fish
+  * @return Y location in pixels, between the last two updates
+  */
+ double GetDrawY(int slot) const { return mWorld->GetDrawY(slot); }
+
+ /**
+  * X speed of a fish
+  * @param slot Slot of the fish
+  * @return Speed in pixels per second
+  */
+ double GetSpeedX(int slot) const { return mWorld->GetSpeedX(slot); }
+
+ /**
+  * Y speed of a fish
+  * @param slot Slot of the fish
+  * @return Speed in pixels per second
+  */
+ double GetSpeedY(int slot) const { return mWorld->GetSpeedY(slot); }
+
+ /**
+  * Set the speed of a fish
+  * @param slot Slot of the fish
+  * @param speedX X speed in pixels per second
+  * @param speedY Y speed in pixels per second
+  */
+ void SetSpeed(int slot, double speedX, double speedY) { mWorld->SetSpeed(slot, speedX, speedY); }
+
+ /**
+  * Is a fish drawn mirrored?
+  * @param slot Slot of the fish
+  * @return True if mirrored
+  */
+ bool GetMirror(int slot) const { return mWorld->GetMirror(slot); }
+
+ /**
+  * Set the mirror flag of a fish
+  * @param slot Slot of the fish
+  * @param mirror True to draw mirrored
+  */
+ void SetMirror(int slot, bool mirror) { mWorld->SetMirror(slot, mirror); }
+
+ /**
+  * Species of a fish
+  * @param slot Slot of the fish
+  * @return The species, which it schools with
+  */
+ FishSpecies GetSpecies(int slot) const { return mWorld->GetSpecies(slot); }
+
+ /**
+  * Set the species of a fish
+  * @param slot Slot of the fish
+  * @param species The species, which it schools with
+  */
+ void SetSpecies(int slot, FishSpecies species) { mWorld->SetSpecies(slot, species); }
+};
+
+#endif //AQUARIUM_FISHSTORE_H
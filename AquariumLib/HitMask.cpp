@@ -0,0 +1,90 @@
+/**
+ * @file HitMask.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the HitMask class.
+ */
+
+#include "pch.h"
+#include "HitMask.h"
+#include <algorithm>
+
+/**
+ * Constructor
+ *
+ * Creates a mask with every pixel transparent.
+ *
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+HitMask::HitMask(int width, int height) :
+    mWidth(width), mHeight(height), mStride((width + 63) / 64),
+    mBits(size_t(mStride) * height, 0)
+{
+ mLeft = width;
+ mTop = height;
+}
+
+/**
+ * Build a mask from an alpha channel
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param alpha Alpha values, width * height bytes, row by row
+ * @param threshold Pixels with alpha below this are transparent
+ * @return The new mask
+ */
+HitMask HitMask::FromAlpha(int width, int height, const unsigned char *alpha, unsigned char threshold)
+{
+ HitMask mask(width, height);
+
+ for (int y = 0; y < height; y++)
+ {
+  auto row = alpha + size_t(y) * width;
+  for (int x = 0; x < width; x++)
+  {
+   if (row[x] >= threshold)
+   {
+    mask.Set(x, y);
+   }
+  }
+ }
+
+ return mask;
+}
+
+/**
+ * Mark a pixel as opaque
+ * @param x X location relative to the left edge
+ * @param y Y location relative to the top edge
+ */
+void HitMask::Set(int x, int y)
+{
+ mBits[size_t(y) * mStride + (x >> 6)] |= uint64_t(1) << (x & 63);
+
+ mLeft = std::min(mLeft, x);
+ mRight = std::max(mRight, x);
+ mTop = std::min(mTop, y);
+ mBottom = std::max(mBottom, y);
+}
+
+/**
+ * Create the mask for the image flipped left to right
+ * @return The mirrored mask
+ */
+HitMask HitMask::Mirror() const
+{
+ HitMask mirror(mWidth, mHeight);
+
+ for (int y = mTop; y <= mBottom; y++)
+ {
+  for (int x = mLeft; x <= mRight; x++)
+  {
+   if (Test(x, y))
+   {
+    mirror.Set(mWidth - 1 - x, y);
+   }
+  }
+ }
+
+ return mirror;
+}
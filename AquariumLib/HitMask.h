@@ -0,0 +1,122 @@
+/**
+ * @file HitMask.h
+ * @author Yeji Lee
+ *
+ * Declaration of the HitMask class.
+ *
+ * A compact one bit per pixel record of which pixels of an
+ * image are opaque, used to hit test items without touching
+ * the full RGBA image.
+ */
+
+#ifndef AQUARIUM_HITMASK_H
+#define AQUARIUM_HITMASK_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * One bit per pixel opacity mask with a tight opaque bounding box.
+ *
+ * Rows are padded to whole 64 bit words so a pixel test is a
+ * shift and a mask on a single word.
+ */
+class HitMask {
+private:
+ /// Width of the mask in pixels
+ int mWidth = 0;
+
+ /// Height of the mask in pixels
+ int mHeight = 0;
+
+ /// Number of 64 bit words in each row
+ int mStride = 0;
+
+ /// The opacity bits, row by row
+ std::vector<uint64_t> mBits;
+
+ // Bounding box of the opaque pixels, empty when right < left
+ int mLeft = 0;      ///< Leftmost opaque column
+ int mTop = 0;       ///< Topmost opaque row
+ int mRight = -1;    ///< Rightmost opaque column
+ int mBottom = -1;   ///< Bottommost opaque row
+
+public:
+ HitMask() = default;
+ HitMask(int width, int height);
+
+ static HitMask FromAlpha(int width, int height, const unsigned char *alpha, unsigned char threshold);
+
+ void Set(int x, int y);
+ HitMask Mirror() const;
+
+ /**
+  * Test a pixel for opacity
+  *
+  * Anything outside the opaque bounding box, including outside
+  * the mask itself, is a miss without looking at the bits.
+  *
+  * @param x X location relative to the left edge
+  * @param y Y location relative to the top edge
+  * @return true if the pixel is opaque
+  */
+ bool Test(int x, int y) const
+ {
+  if (x < mLeft || x > mRight || y < mTop || y > mBottom)
+  {
+   return false;
+  }
+
+  return (mBits[size_t(y) * mStride + (x >> 6)] >> (x & 63)) & 1;
+ }
+
+ /**
+  * Width of the mask
+  * @return Width in pixels
+  */
+ int GetWidth() const { return mWidth; }
+
+ /**
+  * Height of the mask
+  * @return Height in pixels
+  */
+ int GetHeight() const { return mHeight; }
+
+ /**
+  * Is any pixel opaque?
+  * @return true if the mask has no opaque pixels
+  */
+ bool IsEmpty() const { return mRight < mLeft; }
+
+ /**
+  * Leftmost opaque column
+  * @return Column in pixels
+  */
+ int GetLeft() const { return mLeft; }
+
+ /**
+  * Topmost opaque row
+  * @return Row in pixels
+  */
+ int GetTop() const { return mTop; }
+
+ /**
+  * Rightmost opaque column
+  * @return Column in pixels
+  */
+ int GetRight() const { return mRight; }
+
+ /**
+  * Bottommost opaque row
+  * @return Row in pixels
+  */
+ int GetBottom() const { return mBottom; }
+
+ /**
+  * Memory used by the mask bits
+  * @return Size in bytes
+  */
+ size_t GetBytes() const { return mBits.size() * sizeof(uint64_t); }
+};
+
+#endif //AQUARIUM_HITMASK_H
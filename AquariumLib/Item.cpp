@@ -11,6 +11,11 @@
 #include "pch.h"
 #include "Item.h"
 #include "Aquarium.h"
+#include "Sprite.h"
+#include "SpriteCache.h"
+#include "SpriteAtlas.h"
+#include "Snapshot.h"
+#include "PersistSystem.h"
 #include <wx/xml/xml.h>
 
 using namespace std;
@@ -20,10 +25,23 @@ using namespace std;
  * @param aquarium The aquarium this item is a member of
  * @param filename The name of the file to display for this item
  */
-Item::Item(Aquarium *aquarium, const std::wstring &filename) : mAquarium(aquarium)
+Item::Item(Aquarium *aquarium, const std::wstring &filename) : Item(aquarium, filename, Component::Item)
 {
- mItemImage = make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
- mItemBitmap = make_unique<wxBitmap>(*mItemImage);
+}
+
+/**
+ * Constructor, for items with more than the components every item has
+ * @param aquarium The aquarium this item is a member of
+ * @param filename The name of the file to display for this item
+ * @param components Components of the item's entity
+ */
+Item::Item(Aquarium *aquarium, const std::wstring &filename, ComponentMask components) :
+    mAquarium(aquarium), mWorld(aquarium->GetWorld())
+{
+ mSprite = SpriteCache::Instance().Load(filename);
+
+ mEntity = mWorld->Create(components);
+ mWorld->SetHalfSize(mEntity, mSprite->GetWidth() / 2.0, mSprite->GetHeight() / 2.0);
 }
 
 
@@ -32,35 +50,102 @@ Item::Item(Aquarium *aquarium, const std::wstring &filename) : mAquarium(aquariu
  *
  * cleans resources associated with Item.
  *
- * destructor is empty
+ * gives the item's entity back to the world
  */
 Item::~Item()
 {
+ mWorld->Destroy(mEntity);
+}
+
+/**
+ * Set the item location
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ */
+void Item::SetLocation(double x, double y)
+{
+ mWorld->SetLocation(mEntity, x, y);
+
+ if (IsStatic())
+ {
+  mAquarium->StaticChanged();
+ }
+}
+
+/**
+ * Set the mirror status
+ *
+ * The sprite holds both orientations, so this only picks
+ * which one we draw.
+ *
+ * @param m New mirror flag
+ */
+void Item::SetMirror(bool m)
+{
+ mWorld->SetMirror(mEntity, m);
 
+ if (IsStatic())
+ {
+  mAquarium->StaticChanged();
+ }
 }
 
 /**
  * Draw beta fish to aquarium
  *
- * renders beta fish and fish is drawen centered
+ * renders beta fish and fish is drawen centered, blitting from
+ * the sprite atlas when the sprite has been packed into one
  *
  * @param dc Device context to draw on
  */
 void Item::Draw(wxDC *dc)
 {
- double wid = mItemBitmap->GetWidth();
- double hit = mItemBitmap->GetHeight();
+ DrawSprite(dc, *mSprite, GetMirror(), GetDrawX(), GetDrawY(), mAquarium->GetAtlas());
+}
+
+/**
+ * Add this item to a snapshot of the aquarium, with where it
+ * was before the last simulation step so it can be drawn in between
+ * @param snapshot Snapshot being taken
+ */
+void Item::Capture(Snapshot &snapshot) const
+{
+ snapshot.Add(GetHandle(), mSprite, mWorld->GetPrevX(mEntity), mWorld->GetPrevY(mEntity),
+         mWorld->GetX(mEntity), mWorld->GetY(mEntity), mWorld->GetMirror(mEntity));
+}
+
+/**
+ * Draw a sprite centered on a location
+ * @param dc Device context to draw on
+ * @param sprite Sprite to draw
+ * @param mirror True to draw the mirrored orientation
+ * @param x X location of the center
+ * @param y Y location of the center
+ * @param atlas Atlas to draw from if the sprite is in it, may be null
+ */
+void Item::DrawSprite(wxDC *dc, const Sprite &sprite, bool mirror, double x, double y, const SpriteAtlas *atlas)
+{
+ double wid = sprite.GetWidth();
+ double hit = sprite.GetHeight();
+
+ int left = int(x - wid / 2); // x coordinate for centering fish
+ int top = int(y - hit / 2); // y coordinate for centering fish
+
+ if (atlas != nullptr && atlas->Contains(sprite))
+ {
+  atlas->Draw(dc, sprite, mirror, left, top);
+  return;
+ }
 
  // draw fish bitmap centered at position
- dc->DrawBitmap(*mItemBitmap,
-         int(GetX() - wid / 2), // x coordinate for centering fish
-         int(GetY() - hit / 2)); // y coordinate for centering fish
+ dc->DrawBitmap(sprite.GetBitmap(mirror), left, top);
 }
 
 /**
  * Test to see if we hit this object with a mouse.
  *
- * check if x and y coordinates fall in image and takes transparency of image
+ * check if x and y coordinates fall in image and takes transparency of image,
+ * using the opacity mask the sprite shares between every item that uses it
  *
  * @param x X position to test
  * @param y Y position to test
@@ -68,8 +153,8 @@ void Item::Draw(wxDC *dc)
  */
 bool Item::HitTest(int x, int y)
 {
- double wid = mItemBitmap->GetWidth(); // width of fish
- double hit = mItemBitmap->GetHeight(); // height of fish
+ double wid = mSprite->GetWidth(); // width of fish
+ double hit = mSprite->GetHeight(); // height of fish
 
  // Make x and y relative to the top-left corner of the bitmap image
  // Subtracting the center makes x, y relative to the image center
@@ -88,7 +173,7 @@ bool Item::HitTest(int x, int y)
  // Test to see if x, y are in the drawn part of the image
  // If the location is transparent, we are not in the drawn
  // part of the image
- return !mItemImage->IsTransparent((int)testX, (int)testY);
+ return mSprite->GetHitMask(GetMirror()).Test((int)testX, (int)testY);
 
 }
 
@@ -99,46 +184,23 @@ bool Item::HitTest(int x, int y)
  */
 wxXmlNode *Item::XmlSave(wxXmlNode *node)
 {
- auto itemNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"item");
- node->AddChild(itemNode);
-
- itemNode->AddAttribute(L"x", wxString::FromDouble(mX));
- itemNode->AddAttribute(L"y", wxString::FromDouble(mY));
-
- return itemNode;
+ return PersistSystem::Save(*mWorld, mEntity, node);
 }
 
 /**
  * Load the attributes for an item node.
  *
- * This is the  base class version that loads the attributes
- * common to all items. Override this to load custom attributes
- * for specific items.
+ * Loads the location, and the speed of items that have one,
+ * into the item's components.
  *
  * @param node The Xml node we are loading the item from
  */
 void Item::XmlLoad(wxXmlNode *node)
 {
- node->GetAttribute(L"x", L"0").ToDouble(&mX);
- node->GetAttribute(L"y", L"0").ToDouble(&mY);
-}
+ PersistSystem::Load(*mWorld, mEntity, node);
 
-/**
- * Set the mirror status
- * @param m New mirror flag
- */
-void Item::SetMirror(bool m) {
- if (m != mMirror) // Only change if the state is different
+ if (IsStatic())
  {
-  mMirror = m;
-
-  if (mMirror)
-  {
-   mItemBitmap = std::make_unique<wxBitmap>(mItemImage->Mirror());
-  }
-  else
-  {
-   mItemBitmap = std::make_unique<wxBitmap>(*mItemImage);
-  }
+  mAquarium->StaticChanged();
  }
-}
\ No newline at end of file
+}
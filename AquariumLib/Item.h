@@ -7,12 +7,20 @@
  * Serves as the base for all objects in the Aquarium.
  *
  * Provides basic properties like position (X, Y) and manages the association with the aquarium.
+ * The properties are components of the item's entity in the aquarium's ItemWorld.
  */
  
 #ifndef AQUARIUM_ITEM_H
 #define AQUARIUM_ITEM_H
 
+#include <memory>
+#include "ItemHandle.h"
+#include "ItemWorld.h"
+
 class Aquarium;
+class Sprite;
+class SpriteAtlas;
+class Snapshot;
 
 /**
  * Base class for items in the aquarium
@@ -22,24 +30,41 @@ private:
  /// The aquarium this item is contained in
  Aquarium   *mAquarium;
 
- // Item location in the aquarium
- double  mX = 0;     ///< X location for the center of the item
- double  mY = 0;     ///< Y location for the center of the item
-
+ /// World holding this item's components, shared so the item can outlive the aquarium
+ std::shared_ptr<ItemWorld> mWorld;
 
- bool mMirror = false;   ///< True mirrors the item image
+ /// Entity whose components are this item's location, mirror flag and the rest
+ Entity mEntity;
 
+ /// Handle naming this item in its aquarium, set by the aquarium
+ ItemHandle mHandle;
 
+ friend class Aquarium;
 
 protected:
  Item(Aquarium* aquarium, const std::wstring &filename);
+ Item(Aquarium* aquarium, const std::wstring &filename, ComponentMask components);
+
+ /// The shared image and bitmap for this item
+ std::shared_ptr<const Sprite> mSprite;
 
- /// The underlying fish image
+ /**
+  * Get the world holding this item's components
+  * @return Reference to the world
+  */
+ ItemWorld &GetWorld() const { return *mWorld; }
 
- std::unique_ptr<wxImage> mItemImage;
+ /**
+  * Get the entity whose components are this item's state
+  * @return The entity
+  */
+ Entity GetEntity() const { return mEntity; }
 
- /// The bitmap we can display for this fish
- std::unique_ptr<wxBitmap> mItemBitmap;
+ /**
+  * Set the type name this item is saved under
+  * @param type The name, a string that is never freed such as a literal
+  */
+ void SetType(const wchar_t *type) { mWorld->SetType(mEntity, type); }
 
 public:
  /// Default constructor (disabled)
@@ -48,40 +73,67 @@ public:
  /// Copy constructor (disabled)
  Item(const Item &) = delete;
 
- ~Item();
+ virtual ~Item();
 
  /**
   * The X location of the item
   * @returns X location in pixels
   */
- double GetX() const { return mX; }
+ virtual double GetX() const { return mWorld->GetX(mEntity); }
 
  /**
   * The Y location of the item
   * @returns Y location in pixels
   */
- double GetY() const { return mY; }
+ virtual double GetY() const { return mWorld->GetY(mEntity); }
+
+ virtual void SetLocation(double x, double y);
 
  /**
-  * Set the item location
-  * @param x X location in pixels
-  * @param y Y location in pixels
+  * Does this item stay where it is put?
+  *
+  * Static items are not simulated, and the ones behind every
+  * moving item are drawn once into a cached layer with the
+  * background (see StaticLayer).
+  *
+  * @return True if the item never moves by itself
   */
- virtual void SetLocation(double x, double y) { mX = x; mY = y; }
+ virtual bool IsStatic() const { return false; }
+
+ /**
+  * The X location to draw the item at, which for moving
+  * items is between the last two simulation steps
+  * @return X location in pixels
+  */
+ virtual double GetDrawX() const { return mWorld->GetDrawX(mEntity); }
+
+ /**
+  * The Y location to draw the item at
+  * @return Y location in pixels
+  */
+ virtual double GetDrawY() const { return mWorld->GetDrawY(mEntity); }
 
  virtual void Draw(wxDC *dc);
+ virtual void Capture(Snapshot &snapshot) const;
+
+ static void DrawSprite(wxDC *dc, const Sprite &sprite, bool mirror, double x, double y, const SpriteAtlas *atlas);
 
  virtual bool HitTest(int x, int y);
  virtual wxXmlNode* XmlSave(wxXmlNode* node);
  void XmlLoad(wxXmlNode* node);
- void SetMirror(bool m);
+ virtual void SetMirror(bool m);
 
  /**
-  * update function
-  * @param elapsed the time
+  * Get the mirror status
+  * @return True if the item is drawn mirrored
   */
- virtual void Update(double elapsed){}
+ virtual bool GetMirror() const { return mWorld->GetMirror(mEntity); }
 
+ /**
+  * Get the handle naming this item in its aquarium
+  * @return The handle, null until the item is added
+  */
+ ItemHandle GetHandle() const { return mHandle; }
 
  /**
   * Get the pointer to the Aquarium object
@@ -0,0 +1,166 @@
+/**
+ * @file ItemArena.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the ItemArena class.
+ */
+
+#include "pch.h"
+#include "ItemArena.h"
+#include <algorithm>
+
+using namespace std;
+
+/// Slots in the first block of a pool
+const size_t FirstBlockSlots = 64;
+
+/// Most slots in one block
+const size_t MaxBlockSlots = 262144;
+
+/**
+ * Constructor
+ * @param size Size of one slot in bytes
+ * @param alignment Alignment the slots need, at most that of max_align_t
+ */
+ItemPool::ItemPool(size_t size, size_t alignment) : mNextBlockSlots(FirstBlockSlots)
+{
+ // Every slot has to be able to hold the free list link and stay aligned
+ auto align = max(alignment, alignof(FreeSlot));
+ mSlotSize = (max(size, sizeof(FreeSlot)) + align - 1) / align * align;
+}
+
+/**
+ * Take a new block from the heap and make it the one slots come from
+ * @param slots Number of slots in the block
+ */
+void ItemPool::AddBlock(size_t slots)
+{
+ auto bytes = slots * mSlotSize;
+ auto units = (bytes + sizeof(max_align_t) - 1) / sizeof(max_align_t);
+ mBlocks.push_back(make_unique<max_align_t[]>(units));
+
+ mUnused = reinterpret_cast<char *>(mBlocks.back().get());
+ mUnusedEnd = mUnused + bytes;
+}
+
+/**
+ * Hand out a slot, reusing a freed one if there is one
+ * @return Memory for one object
+ */
+void *ItemPool::Allocate()
+{
+ mLive++;
+
+ if (mFree != nullptr)
+ {
+  auto slot = mFree;
+  mFree = slot->next;
+  return slot;
+ }
+
+ if (mUnused == mUnusedEnd)
+ {
+  AddBlock(mNextBlockSlots);
+  mNextBlockSlots = min(mNextBlockSlots * 2, MaxBlockSlots);
+ }
+
+ auto slot = mUnused;
+ mUnused += mSlotSize;
+ return slot;
+}
+
+/**
+ * Give a slot back for reuse
+ * @param slot Memory from Allocate
+ */
+void ItemPool::Deallocate(void *slot)
+{
+ auto free = static_cast<FreeSlot *>(slot);
+ free->next = mFree;
+ mFree = free;
+ mLive--;
+}
+
+/**
+ * Give every block back to the heap, if no slot is in use
+ * @return True if the pool is now empty
+ */
+bool ItemPool::Release()
+{
+ if (mLive != 0)
+ {
+  return false;
+ }
+
+ mBlocks.clear();
+ mUnused = mUnusedEnd = nullptr;
+ mFree = nullptr;
+ mNextBlockSlots = FirstBlockSlots;
+ return true;
+}
+
+/**
+ * Get the pool for a type, making it the first time
+ * @param type The type
+ * @param size Size of the type in bytes
+ * @param alignment Alignment of the type
+ * @return The pool
+ */
+ItemPool &ItemArena::GetPool(std::type_index type, size_t size, size_t alignment)
+{
+ auto &pool = mPools[type];
+ if (pool == nullptr)
+ {
+  pool = make_unique<ItemPool>(size, alignment);
+ }
+
+ return *pool;
+}
+
+/**
+ * Give the blocks of every pool with nothing in use back to the heap
+ * @return Number of pools still holding live objects
+ */
+size_t ItemArena::Release()
+{
+ size_t busy = 0;
+ for (auto &pool : mPools)
+ {
+  if (!pool.second->Release())
+  {
+   busy++;
+  }
+ }
+
+ return busy;
+}
+
+/**
+ * Number of objects in use over every pool
+ * @return Live object count
+ */
+size_t ItemArena::GetLive() const
+{
+ size_t live = 0;
+ for (auto &pool : mPools)
+ {
+  live += pool.second->GetLive();
+ }
+
+ return live;
+}
+
+/**
+ * Number of blocks taken from the heap over every pool
+ * @return Block count
+ */
+size_t ItemArena::GetBlockCount() const
+{
+ size_t blocks = 0;
+ for (auto &pool : mPools)
+ {
+  blocks += pool.second->GetBlockCount();
+ }
+
+ return blocks;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ItemArena.h
+ * @author Yeji Lee
+ *
+ * Declaration of the ItemArena class.
+ *
+ * Memory for items, handed out from large blocks with one pool per
+ * species instead of one heap allocation per item.
+ */
+
+#ifndef AQUARIUM_ITEMARENA_H
+#define AQUARIUM_ITEMARENA_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+/**
+ * Pool of equal sized slots carved out of large blocks.
+ *
+ * Freed slots go on a free list and are reused before any new
+ * block is taken. Each block is twice the size of the one before,
+ * up to a limit, so a million items take about fifteen allocations.
+ */
+class ItemPool {
+private:
+ /// A freed slot, linked to the next one
+ struct FreeSlot {
+  FreeSlot *next;   ///< Next free slot or nullptr
+ };
+
+ /// Size of one slot in bytes
+ size_t mSlotSize;
+
+ /// Slots in the next block to be taken
+ size_t mNextBlockSlots;
+
+ /// The blocks, each holding many slots
+ std::vector<std::unique_ptr<std::max_align_t[]>> mBlocks;
+
+ /// Slots not yet handed out at the end of the newest block
+ char *mUnused = nullptr;
+
+ /// End of the newest block
+ char *mUnusedEnd = nullptr;
+
+ /// Freed slots waiting to be reused
+ FreeSlot *mFree = nullptr;
+
+ /// Slots handed out and not yet freed
+ size_t mLive = 0;
+
+ void AddBlock(size_t slots);
+
+public:
+ ItemPool(size_t size, size_t alignment);
+
+ /// Copy constructor (disabled)
+ ItemPool(const ItemPool &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const ItemPool &) = delete;
+
+ void *Allocate();
+ void Deallocate(void *slot);
+ bool Release();
+
+ /**
+  * Number of slots in use
+  * @return Live slot count
+  */
+ size_t GetLive() const { return mLive; }
+
+ /**
+  * Number of blocks taken from the heap
+  * @return Block count
+  */
+ size_t GetBlockCount() const { return mBlocks.size(); }
+};
+
+/**
+ * One ItemPool per type of object allocated through it.
+ *
+ * The aquarium creates its items with std::allocate_shared and an
+ * ItemAllocator, so each species' objects, reference counts
+ * included, come from that species' pool. The arena is shared by the
+ * allocators, so it lives until the last item is gone even if the
+ * aquarium goes first.
+ *
+ * Not thread safe, items are created and destroyed by whichever
+ * thread holds the aquarium.
+ */
+class ItemArena {
+private:
+ /// The pools, by the type they hold
+ std::map<std::type_index, std::unique_ptr<ItemPool>> mPools;
+
+public:
+ ItemPool &GetPool(std::type_index type, size_t size, size_t alignment);
+ size_t Release();
+
+ size_t GetLive() const;
+ size_t GetBlockCount() const;
+};
+
+/**
+ * Standard allocator that takes memory from an ItemArena
+ * @tparam T Type allocated
+ */
+template <class T>
+class ItemAllocator {
+private:
+ template <class U> friend class ItemAllocator;
+
+ /// Arena the memory comes from
+ std::shared_ptr<ItemArena> mArena;
+
+ /// Pool for T, looked up the first time it is needed
+ ItemPool *mPool = nullptr;
+
+public:
+ /// Type allocated
+ typedef T value_type;
+
+ /**
+  * Constructor
+  * @param arena Arena to take memory from
+  */
+ explicit ItemAllocator(std::shared_ptr<ItemArena> arena) : mArena(std::move(arena)) {}
+
+ /**
+  * Constructor for another type from the same arena
+  * @param other Allocator to copy the arena from
+  */
+ template <class U>
+ ItemAllocator(const ItemAllocator<U> &other) : mArena(other.mArena) {}
+
+ /**
+  * Allocate memory for objects
+  * @param n Number of objects, pooled if 1
+  * @return The memory
+  */
+ T *allocate(size_t n)
+ {
+  if (n != 1)
+  {
+   return std::allocator<T>().allocate(n);
+  }
+
+  if (mPool == nullptr)
+  {
+   mPool = &mArena->GetPool(typeid(T), sizeof(T), alignof(T));
+  }
+
+  return static_cast<T *>(mPool->Allocate());
+ }
+
+ /**
+  * Free memory from allocate
+  * @param p The memory
+  * @param n Number of objects it was allocated for
+  */
+ void deallocate(T *p, size_t n)
+ {
+  if (n != 1)
+  {
+   std::allocator<T>().deallocate(p, n);
+   return;
+  }
+
+  if (mPool == nullptr)
+  {
+   mPool = &mArena->GetPool(typeid(T), sizeof(T), alignof(T));
+  }
+
+  mPool->Deallocate(p);
+ }
+
+ /**
+  * Allocators are equal if they share an arena
+  * @param other Allocator to compare with
+  * @return True if either can free the other's memory
+  */
+ template <class U>
+ bool operator==(const ItemAllocator<U> &other) const { return mArena == other.mArena; }
+
+ /**
+  * Allocators are equal if they share an arena
+  * @param other Allocator to compare with
+  * @return True if neither can free the other's memory
+  */
+ template <class U>
+ bool operator!=(const ItemAllocator<U> &other) const { return mArena != other.mArena; }
+};
+
+#endif //AQUARIUM_ITEMARENA_H
@@ -0,0 +1,72 @@
+/**
+ * @file ItemFactory.h
+ * @author Yeji Lee
+ *
+ * Declaration of the ItemFactory class template.
+ *
+ * Creates items from the type name they are saved under.
+ */
+
+#ifndef AQUARIUM_ITEMFACTORY_H
+#define AQUARIUM_ITEMFACTORY_H
+
+#include <memory>
+#include "ItemArena.h"
+#include "PerfectHash.h"
+
+class Aquarium;
+class Item;
+
+/**
+ * Creates any of a fixed list of item types from its type name.
+ *
+ * Each type says the name it is saved under as a static Type.
+ * The names are put in a PerfectHash by the compiler, so finding
+ * the type of an item being loaded takes the same time however
+ * many types there are. Adding a type is adding it to the list.
+ *
+ * @tparam Types The item types, each made with an Aquarium pointer
+ */
+template <class... Types>
+class ItemFactory {
+private:
+ /// Function that creates one type of item
+ typedef std::shared_ptr<Item> (*Creator)(Aquarium *aquarium, const std::shared_ptr<ItemArena> &arena);
+
+ /**
+  * Create an item in the arena pool for its type
+  * @tparam T Type of item
+  * @param aquarium Aquarium the item is a member of
+  * @param arena Arena to create it in
+  * @return The new item
+  */
+ template <class T>
+ static std::shared_ptr<Item> Make(Aquarium *aquarium, const std::shared_ptr<ItemArena> &arena)
+ {
+  return std::allocate_shared<T>(ItemAllocator<T>(arena), aquarium);
+ }
+
+ /// Creators, in the same order as the names
+ static constexpr Creator Creators[] = {&Make<Types>...};
+
+public:
+ /// The type names, in the order of Types
+ static constexpr PerfectHash<sizeof...(Types)> Names{{{Types::Type...}}};
+
+ static_assert(Names.IsPerfect(), "Item type names must all be different");
+
+ /**
+  * Create an item from its type name
+  * @param type Type name, such as L"beta"
+  * @param aquarium Aquarium the item is a member of
+  * @param arena Arena to create it in
+  * @return The new item, not yet added, or nullptr for an unknown type
+  */
+ static std::shared_ptr<Item> Create(const wchar_t *type, Aquarium *aquarium, const std::shared_ptr<ItemArena> &arena)
+ {
+  auto index = Names.Find(type);
+  return index < 0 ? nullptr : Creators[index](aquarium, arena);
+ }
+};
+
+#endif //AQUARIUM_ITEMFACTORY_H
@@ -0,0 +1,53 @@
+/**
+ * @file ItemHandle.h
+ * @author Yeji Lee
+ *
+ * Declaration of the ItemHandle struct.
+ *
+ * A small copyable name for an item in an aquarium that can be
+ * checked for whether the item still exists.
+ */
+
+#ifndef AQUARIUM_ITEMHANDLE_H
+#define AQUARIUM_ITEMHANDLE_H
+
+#include <cstdint>
+
+/**
+ * Generational handle to an item.
+ *
+ * The index picks a slot in the aquarium's handle table and the
+ * generation says which use of that slot is meant. When an item
+ * leaves the aquarium its slot's generation goes up, so a handle
+ * kept from before no longer matches and finds nothing, even after
+ * the slot goes to a new item.
+ */
+struct ItemHandle {
+ /// Index that no slot has
+ static constexpr uint32_t NoIndex = UINT32_MAX;
+
+ uint32_t index = NoIndex;    ///< Slot in the handle table
+ uint32_t generation = 0;     ///< Use of the slot this handle names
+
+ /**
+  * Is this the handle of no item at all?
+  * @return True for a default constructed handle
+  */
+ bool IsNull() const { return index == NoIndex; }
+
+ /**
+  * Do two handles name the same item?
+  * @param other Handle to compare with
+  * @return True if they do
+  */
+ bool operator==(const ItemHandle &other) const { return index == other.index && generation == other.generation; }
+
+ /**
+  * Do two handles name different items?
+  * @param other Handle to compare with
+  * @return True if they do
+  */
+ bool operator!=(const ItemHandle &other) const { return !(*this == other); }
+};
+
+#endif //AQUARIUM_ITEMHANDLE_H
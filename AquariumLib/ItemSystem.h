@@ -0,0 +1,95 @@
+/**
+ * @file ItemSystem.h
+ * @author Yeji Lee
+ *
+ * Declaration of the ItemSystem class.
+ *
+ * Base class for the systems that update the entities of an
+ * ItemWorld, one table of components at a time.
+ */
+
+#ifndef AQUARIUM_ITEMSYSTEM_H
+#define AQUARIUM_ITEMSYSTEM_H
+
+#include <algorithm>
+#include <cstddef>
+#include "ItemWorld.h"
+
+/**
+ * One behavior of the entities in an ItemWorld.
+ *
+ * Each update the world asks every system to Prepare, then calls
+ * Run on chunks of rows of each table that has all the components
+ * the system needs, spread over the worker pool. Tables without
+ * them are never handed to the system. A chunk must only touch its
+ * own rows, so the result is the same whatever thread runs it.
+ */
+class ItemSystem {
+public:
+ /// Fewest rows a worker updates at a time, a multiple of every kernel width
+ static constexpr size_t MinChunk = 1024;
+
+ /// Chunks each thread should get of a table, so a slow one does not hold up the rest
+ static constexpr size_t ChunksPerThread = 4;
+
+ /**
+  * Rows each worker updates at a time.
+  *
+  * Big enough that handing out a chunk costs little next to
+  * running it, small enough that every thread gets several. Every
+  * row draws from its own random stream, so the chunk size does not
+  * change the result.
+  *
+  * @param count Rows in the table
+  * @param threads Threads in the worker pool
+  * @return Rows per chunk, a multiple of MinChunk
+  */
+ static size_t GetChunk(size_t count, int threads)
+ {
+  auto chunk = count / (size_t(threads) * ChunksPerThread);
+  return std::max(MinChunk, chunk / MinChunk * MinChunk);
+ }
+
+ /// Destructor
+ virtual ~ItemSystem() {}
+
+ /**
+  * The components an entity needs for this system to update it
+  * @return Component bits
+  */
+ virtual ComponentMask GetComponents() const = 0;
+
+ /**
+  * Get ready for an update, before any table is run
+  * @param world The world being updated
+  * @param elapsed Time since the last update in seconds
+  * @param width Width of the aquarium in pixels
+  * @param height Height of the aquarium in pixels
+  * @return false to sit this update out
+  */
+ virtual bool Prepare(ItemWorld &world, double elapsed, double width, double height) { return true; }
+
+ /**
+  * Does updating a row depend on nothing but that row?
+  *
+  * When every system running on a table says so, a batch of
+  * steps is Prepared once and then run one chunk at a time, all
+  * the steps on a chunk while it is in cache.
+  *
+  * @return false unless the system says otherwise
+  */
+ virtual bool IsRowLocal() const { return false; }
+
+ /**
+  * Update some rows of a table
+  * @param table Table that has every component of GetComponents
+  * @param begin First row to do
+  * @param end One past the last row to do
+  * @param elapsed Time since the last update in seconds
+  * @param width Width of the aquarium in pixels
+  * @param height Height of the aquarium in pixels
+  */
+ virtual void Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height) = 0;
+};
+
+#endif //AQUARIUM_ITEMSYSTEM_H
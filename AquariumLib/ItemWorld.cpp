@@ -0,0 +1,460 @@
+/**
+ * @file ItemWorld.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the ItemWorld class.
+ */
+
+#include "pch.h"
+#include "ItemWorld.h"
+#include "ItemSystem.h"
+#include "MotionSystem.h"
+#include "JitterSystem.h"
+#include "SchoolSystem.h"
+#include "WorkerPool.h"
+#include "CounterRandom.h"
+
+using namespace std;
+
+/**
+ * Visit each component array of two tables side by side
+ * @param table Table whose arrays are visited
+ * @param other Table whose matching arrays are visited along with them
+ * @param visit Called with an array of table, the same array of other
+ * and the component the array belongs to
+ */
+template <class Visit>
+static void ForEachColumn(ItemTable &table, ItemTable &other, Visit visit)
+{
+ visit(table.x, other.x, Component::Transform);
+ visit(table.y, other.y, Component::Transform);
+ visit(table.prevX, other.prevX, Component::Transform);
+ visit(table.prevY, other.prevY, Component::Transform);
+ visit(table.mirror, other.mirror, Component::Transform);
+ visit(table.speedX, other.speedX, Component::Velocity);
+ visit(table.speedY, other.speedY, Component::Velocity);
+ visit(table.halfWidth, other.halfWidth, Component::Sprite);
+ visit(table.halfHeight, other.halfHeight, Component::Sprite);
+ visit(table.jitterTime, other.jitterTime, Component::Jitter);
+ visit(table.stream, other.stream, Component::Jitter);
+ visit(table.draws, other.draws, Component::Jitter);
+ visit(table.species, other.species, Component::School);
+ visit(table.type, other.type, Component::Persist);
+}
+
+/**
+ * Add a row with every component zeroed
+ * @param owner Entity the row is for
+ * @return The new row
+ */
+uint32_t ItemTable::AddRow(Entity owner)
+{
+ entity.push_back(owner);
+ ForEachColumn(*this, *this, [this](auto &column, auto &, ComponentMask component) {
+  if (mask & component)
+  {
+   column.emplace_back();
+  }
+ });
+
+ return (uint32_t)entity.size() - 1;
+}
+
+/**
+ * Add a row holding a row of another table.
+ *
+ * Components both tables have are copied, ones only this table
+ * has are zeroed. The row is not removed from the other table.
+ *
+ * @param from Table to copy from
+ * @param row Row in that table
+ * @return The new row
+ */
+uint32_t ItemTable::MoveRow(ItemTable &from, uint32_t row)
+{
+ entity.push_back(from.entity[row]);
+ ForEachColumn(*this, from, [this, &from, row](auto &column, auto &other, ComponentMask component) {
+  if (mask & component)
+  {
+   if (from.mask & component)
+   {
+    column.push_back(other[row]);
+   }
+   else
+   {
+    column.emplace_back();
+   }
+  }
+ });
+
+ return (uint32_t)entity.size() - 1;
+}
+
+/**
+ * Remove a row, moving the last row into its place
+ * @param row Row to remove
+ * @return Entity now in that row, or the removed one if it was the last row
+ */
+Entity ItemTable::RemoveRow(uint32_t row)
+{
+ auto last = entity.size() - 1;
+ ForEachColumn(*this, *this, [this, row, last](auto &column, auto &, ComponentMask component) {
+  if (mask & component)
+  {
+   column[row] = column[last];
+   column.pop_back();
+  }
+ });
+
+ auto moved = entity[last];
+ entity[row] = moved;
+ entity.pop_back();
+ return moved;
+}
+
+/**
+ * Make room for a number of rows without reallocating
+ * @param count Total number of rows to make room for
+ */
+void ItemTable::Reserve(size_t count)
+{
+ entity.reserve(count);
+ ForEachColumn(*this, *this, [this, count](auto &column, auto &, ComponentMask component) {
+  if (mask & component)
+  {
+   column.reserve(count);
+  }
+ });
+}
+
+/**
+ * Remove every row
+ */
+void ItemTable::Clear()
+{
+ entity.clear();
+ ForEachColumn(*this, *this, [](auto &column, auto &, ComponentMask) {
+  column.clear();
+ });
+}
+
+/**
+ * Constructor, with the standard systems: schooling, then
+ * moving, then jitter
+ */
+ItemWorld::ItemWorld() : mPool(&WorkerPool::Instance())
+{
+ auto school = make_unique<SchoolSystem>();
+ mSchool = school.get();
+ AddSystem(std::move(school));
+
+ auto motion = make_unique<MotionSystem>();
+ mMotion = motion.get();
+ AddSystem(std::move(motion));
+
+ AddSystem(make_unique<JitterSystem>());
+}
+
+/**
+ * Destructor
+ */
+ItemWorld::~ItemWorld()
+{
+}
+
+/**
+ * Get the table for a set of components, making it the first time
+ * @param mask The components
+ * @return The table
+ */
+ItemTable &ItemWorld::GetTable(ComponentMask mask)
+{
+ for (auto &table : mTables)
+ {
+  if (table->mask == mask)
+  {
+   return *table;
+  }
+ }
+
+ mTables.push_back(make_unique<ItemTable>());
+ mTables.back()->mask = mask;
+ return *mTables.back();
+}
+
+/**
+ * Fill in components that do not start out zero
+ * @param table Table of the entity
+ * @param row Row of the entity
+ * @param components Components just given to the entity
+ */
+void ItemWorld::Added(ItemTable &table, uint32_t row, ComponentMask components)
+{
+ if (components & Component::Jitter)
+ {
+  table.stream[row] = CounterRandom::Key(mSeed, mNextStream++);
+ }
+}
+
+/**
+ * Make an entity at the origin with every component zeroed
+ * @param components Components it has
+ * @return The entity
+ */
+Entity ItemWorld::Create(ComponentMask components)
+{
+ Entity entity;
+ if (!mFree.empty())
+ {
+  entity = mFree.back();
+  mFree.pop_back();
+ }
+ else
+ {
+  entity = (Entity)mRecords.size();
+  mRecords.emplace_back();
+ }
+
+ auto &table = GetTable(components);
+ auto row = table.AddRow(entity);
+ mRecords[entity] = {&table, row};
+ Added(table, row, components);
+ return entity;
+}
+
+/**
+ * Destroy an entity and its components
+ * @param entity The entity
+ */
+void ItemWorld::Destroy(Entity entity)
+{
+ auto &record = mRecords[entity];
+ auto moved = record.table->RemoveRow(record.row);
+ mRecords[moved].row = record.row;
+
+ record.table = nullptr;
+ mFree.push_back(entity);
+}
+
+/**
+ * Give an entity more components, moving it to the table for
+ * its new set of them
+ * @param entity The entity
+ * @param components Components to add, zeroed, any it has are kept
+ */
+void ItemWorld::AddComponents(Entity entity, ComponentMask components)
+{
+ auto &record = mRecords[entity];
+ auto &from = *record.table;
+ auto mask = from.mask | components;
+ if (mask == from.mask)
+ {
+  return;
+ }
+
+ auto &to = GetTable(mask);
+ auto row = to.MoveRow(from, record.row);
+ auto moved = from.RemoveRow(record.row);
+ mRecords[moved].row = record.row;
+ record = {&to, row};
+ Added(to, row, components & ~from.mask);
+}
+
+/**
+ * Take components away from an entity, moving it to the table
+ * for its new set of them
+ * @param entity The entity
+ * @param components Components to remove
+ */
+void ItemWorld::RemoveComponents(Entity entity, ComponentMask components)
+{
+ auto &record = mRecords[entity];
+ auto &from = *record.table;
+ auto mask = from.mask & ~components;
+ if (mask == from.mask)
+ {
+  return;
+ }
+
+ auto &to = GetTable(mask);
+ auto row = to.MoveRow(from, record.row);
+ auto moved = from.RemoveRow(record.row);
+ mRecords[moved].row = record.row;
+ record = {&to, row};
+}
+
+/**
+ * Make room for a number of entities with a set of components
+ * @param components The components
+ * @param count Total number of such entities to make room for
+ */
+void ItemWorld::Reserve(ComponentMask components, size_t count)
+{
+ GetTable(components).Reserve(count);
+ mRecords.reserve(count);
+}
+
+/**
+ * Destroy every entity.
+ *
+ * Only use this when nothing holds an entity any more.
+ */
+void ItemWorld::Clear()
+{
+ for (auto &table : mTables)
+ {
+  table->Clear();
+ }
+
+ mRecords.clear();
+ mFree.clear();
+}
+
+/**
+ * Number of entities with every one of some components
+ * @param components The components
+ * @return Entity count
+ */
+size_t ItemWorld::GetCount(ComponentMask components) const
+{
+ size_t count = 0;
+ for (auto &table : mTables)
+ {
+  if (table->Has(components))
+  {
+   count += table->GetCount();
+  }
+ }
+
+ return count;
+}
+
+/**
+ * Add a system, to run after the ones already added
+ * @param system The system
+ */
+void ItemWorld::AddSystem(std::unique_ptr<ItemSystem> system)
+{
+ mSystems.push_back(std::move(system));
+}
+
+/**
+ * Run every system on the tables it applies to.
+ *
+ * Each table is cut into chunks spread over the worker pool, and
+ * each chunk goes through the table's systems in order, so a chunk
+ * is still in cache from one system to the next. Tables no system
+ * applies to, such as decor, are never visited.
+ *
+ * Several steps at once are run a chunk at a time too, every step
+ * on a chunk before the next, if all the systems taking part are
+ * row local (see ItemSystem::IsRowLocal). Otherwise, as when fish
+ * school, each step goes over the whole world in turn. Either way
+ * the result is the same as that many single steps.
+ *
+ * @param elapsed Time each step simulates in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ * @param steps Number of steps to run
+ */
+void ItemWorld::Update(double elapsed, double width, double height, int steps)
+{
+ if (steps <= 0)
+ {
+  return;
+ }
+
+ if (PrepareSystems(elapsed, width, height))
+ {
+  RunSystems(elapsed, width, height, steps);
+  return;
+ }
+
+ // Some system needs the whole world as the last step left it
+ RunSystems(elapsed, width, height, 1);
+ for (int step = 1; step < steps; step++)
+ {
+  PrepareSystems(elapsed, width, height);
+  RunSystems(elapsed, width, height, 1);
+ }
+}
+
+/**
+ * Get every system ready for a step and gather the ones taking part
+ * @param elapsed Time the step simulates in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ * @return true if every system taking part is row local
+ */
+bool ItemWorld::PrepareSystems(double elapsed, double width, double height)
+{
+ mActive.clear();
+ bool local = true;
+ for (auto &system : mSystems)
+ {
+  if (system->Prepare(*this, elapsed, width, height))
+  {
+   mActive.push_back(system.get());
+   local = local && system->IsRowLocal();
+  }
+ }
+
+ return local;
+}
+
+/**
+ * Run the systems taking part on the tables they apply to
+ * @param elapsed Time each step simulates in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ * @param steps Steps to run on each chunk before moving to the next
+ */
+void ItemWorld::RunSystems(double elapsed, double width, double height, int steps)
+{
+ for (auto &table : mTables)
+ {
+  mRunning.clear();
+  for (auto system : mActive)
+  {
+   if (table->Has(system->GetComponents()))
+   {
+    mRunning.push_back(system);
+   }
+  }
+
+  if (mRunning.empty() || table->GetCount() == 0)
+  {
+   continue;
+  }
+
+  auto &rows = *table;
+  auto chunk = ItemSystem::GetChunk(rows.GetCount(), mPool->GetThreadCount());
+  mPool->Run(rows.GetCount(), chunk, [&](size_t begin, size_t end) {
+   for (int step = 0; step < steps; step++)
+   {
+    for (auto system : mRunning)
+    {
+     system->Run(rows, begin, end, elapsed, width, height);
+    }
+   }
+  });
+ }
+}
+
+/**
+ * Choose the kernel that moves entities, for comparing them
+ * @param kernel Kernel level, falls back to scalar if unsupported
+ */
+void ItemWorld::SetKernel(FishKernel::Level kernel)
+{
+ mMotion->SetKernel(kernel);
+}
+
+/**
+ * Get the schooling settings
+ * @return Reference to the schooling settings, off unless enabled
+ */
+Schooling &ItemWorld::GetSchooling()
+{
+ return mSchool->GetSchooling();
+}
@@ -0,0 +1,381 @@
+/**
+ * @file ItemWorld.h
+ * @author Yeji Lee
+ *
+ * Declaration of the ItemWorld class.
+ *
+ * The state of every item in an aquarium as entities with
+ * components, kept in tables of parallel arrays and updated by
+ * systems, with the Item classes as views over their entity.
+ */
+
+#ifndef AQUARIUM_ITEMWORLD_H
+#define AQUARIUM_ITEMWORLD_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "FishKernel.h"
+#include "Schooling.h"
+
+class WorkerPool;
+class ItemSystem;
+class MotionSystem;
+class SchoolSystem;
+
+/// Names one item in an ItemWorld
+typedef uint32_t Entity;
+
+/// A set of components, one bit each
+typedef uint32_t ComponentMask;
+
+/**
+ * The components an entity can have.
+ *
+ * Bits not used here are free for components with no arrays,
+ * which only mark which systems apply to an entity.
+ */
+namespace Component {
+ const ComponentMask Transform = 1 << 0;   ///< Location, location before the last step and mirror flag
+ const ComponentMask Velocity = 1 << 1;    ///< Speed
+ const ComponentMask Sprite = 1 << 2;      ///< Half the sprite size, for bouncing off the walls
+ const ComponentMask Jitter = 1 << 3;      ///< Timer and random stream for vertical speed changes
+ const ComponentMask School = 1 << 4;      ///< Species, for schooling
+ const ComponentMask Persist = 1 << 5;     ///< Type name the item is saved under
+
+ /// What every item has
+ const ComponentMask Item = Transform | Sprite | Persist;
+
+ /// What every fish has
+ const ComponentMask Fish = Item | Velocity | Jitter | School;
+}
+
+/**
+ * Every entity with one exact set of components.
+ *
+ * Each component is one or more arrays with an entry per row,
+ * and only the arrays of the table's components are used, so a
+ * system walks contiguous memory holding only what it needs.
+ * Rows are kept dense, removing one moves the last row into it.
+ */
+struct ItemTable {
+ ComponentMask mask = 0;                 ///< Components of the entities in this table
+ std::vector<Entity> entity;             ///< Entity in each row
+
+ // Transform
+ std::vector<double> x;                  ///< X location of the center
+ std::vector<double> y;                  ///< Y location of the center
+ std::vector<double> prevX;              ///< X location before the last step
+ std::vector<double> prevY;              ///< Y location before the last step
+ std::vector<uint8_t> mirror;            ///< Nonzero if drawn mirrored
+
+ // Velocity
+ std::vector<double> speedX;             ///< X speed in pixels per second
+ std::vector<double> speedY;             ///< Y speed in pixels per second
+
+ // Sprite
+ std::vector<double> halfWidth;          ///< Half the sprite width
+ std::vector<double> halfHeight;         ///< Half the sprite height
+
+ // Jitter
+ std::vector<double> jitterTime;         ///< Time since the last vertical speed change
+ std::vector<uint64_t> stream;           ///< Key of the entity's random stream
+ std::vector<uint64_t> draws;            ///< Random numbers taken from the stream so far
+
+ // School
+ std::vector<uint8_t> species;           ///< FishSpecies of the fish
+
+ // Persist
+ std::vector<const wchar_t *> type;      ///< Type name saved, a string that is never freed, or null
+
+ /**
+  * Number of rows
+  * @return Entity count
+  */
+ size_t GetCount() const { return entity.size(); }
+
+ /**
+  * Does this table have every one of some components?
+  * @param components The components
+  * @return True if it has them all
+  */
+ bool Has(ComponentMask components) const { return (mask & components) == components; }
+
+ uint32_t AddRow(Entity owner);
+ uint32_t MoveRow(ItemTable &from, uint32_t row);
+ Entity RemoveRow(uint32_t row);
+ void Reserve(size_t count);
+ void Clear();
+};
+
+/**
+ * Entities, their components and the systems that update them.
+ *
+ * Entities with the same components share an ItemTable. Update
+ * hands each table to the systems that need only components it
+ * has, so a fish without some behavior never pays for it: adding
+ * a behavior is a component bit, its arrays in ItemTable and an
+ * ItemSystem, and only the tables with that bit are visited.
+ *
+ * Entity numbers are reused once destroyed and stay the same
+ * while the entity lives, whatever rows move under it.
+ */
+class ItemWorld {
+private:
+ /// Where an entity's components are
+ struct Record {
+  ItemTable *table = nullptr;     ///< Table holding the entity, null if destroyed
+  uint32_t row = 0;               ///< Row in the table
+ };
+
+ /// The tables, one per set of components seen so far
+ std::vector<std::unique_ptr<ItemTable>> mTables;
+
+ /// Where each entity is, indexed by entity
+ std::vector<Record> mRecords;
+
+ /// Destroyed entities waiting to be reused
+ std::vector<Entity> mFree;
+
+ /// The systems, in the order they run
+ std::vector<std::unique_ptr<ItemSystem>> mSystems;
+
+ /// Systems taking part in the update being run
+ std::vector<ItemSystem *> mActive;
+
+ /// Systems that apply to the table being updated
+ std::vector<ItemSystem *> mRunning;
+
+ /// The system that moves entities
+ MotionSystem *mMotion;
+
+ /// The system that steers fish in schools
+ SchoolSystem *mSchool;
+
+ /// Seed the random stream keys are made from
+ uint64_t mSeed = 0;
+
+ /// Number of random streams handed out
+ uint64_t mNextStream = 0;
+
+ /// Threads the systems run on
+ WorkerPool *mPool;
+
+ /// How far from the previous to the current location entities are drawn
+ double mInterpolation = 1;
+
+ ItemTable &GetTable(ComponentMask mask);
+ void Added(ItemTable &table, uint32_t row, ComponentMask components);
+ bool PrepareSystems(double elapsed, double width, double height);
+ void RunSystems(double elapsed, double width, double height, int steps);
+
+public:
+ ItemWorld();
+ ~ItemWorld();
+
+ /// Copy constructor (disabled)
+ ItemWorld(const ItemWorld &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const ItemWorld &) = delete;
+
+ Entity Create(ComponentMask components);
+ void Destroy(Entity entity);
+ void AddComponents(Entity entity, ComponentMask components);
+ void RemoveComponents(Entity entity, ComponentMask components);
+ void Reserve(ComponentMask components, size_t count);
+ void Clear();
+
+ size_t GetCount(ComponentMask components) const;
+
+ void AddSystem(std::unique_ptr<ItemSystem> system);
+ void Update(double elapsed, double width, double height, int steps = 1);
+
+ void SetKernel(FishKernel::Level kernel);
+ Schooling &GetSchooling();
+
+ /**
+  * Does an entity have every one of some components?
+  * @param entity The entity
+  * @param components The components
+  * @return True if it has them all
+  */
+ bool Has(Entity entity, ComponentMask components) const { return mRecords[entity].table->Has(components); }
+
+ /**
+  * Get the tables, for systems that look at every entity at once
+  * @return The tables, some may be empty
+  */
+ const std::vector<std::unique_ptr<ItemTable>> &GetTables() const { return mTables; }
+
+ /**
+  * Set the seed for the random streams of entities given a Jitter component from now on
+  * @param seed Seed value
+  */
+ void SetSeed(uint64_t seed) { mSeed = seed; mNextStream = 0; }
+
+ /**
+  * Choose the threads the systems run on
+  * @param pool Worker pool to use, the process-wide one by default
+  */
+ void SetWorkerPool(WorkerPool *pool) { mPool = pool; }
+
+ /**
+  * Get the threads the systems run on
+  * @return The worker pool
+  */
+ WorkerPool &GetWorkerPool() const { return *mPool; }
+
+ /**
+  * Set how far between the last two updates entities are drawn
+  * @param alpha 0 for the previous locations, 1 for the current ones
+  */
+ void SetInterpolation(double alpha) { mInterpolation = alpha; }
+
+ /**
+  * X location of an entity
+  * @param entity Entity with a Transform
+  * @return X location of the center in pixels
+  */
+ double GetX(Entity entity) const { auto &r = mRecords[entity]; return r.table->x[r.row]; }
+
+ /**
+  * Y location of an entity
+  * @param entity Entity with a Transform
+  * @return Y location of the center in pixels
+  */
+ double GetY(Entity entity) const { auto &r = mRecords[entity]; return r.table->y[r.row]; }
+
+ /**
+  * X location of an entity before the last update
+  * @param entity Entity with a Transform
+  * @return X location in pixels
+  */
+ double GetPrevX(Entity entity) const { auto &r = mRecords[entity]; return r.table->prevX[r.row]; }
+
+ /**
+  * Y location of an entity before the last update
+  * @param entity Entity with a Transform
+  * @return Y location in pixels
+  */
+ double GetPrevY(Entity entity) const { auto &r = mRecords[entity]; return r.table->prevY[r.row]; }
+
+ /**
+  * Set the location of an entity, with no interpolation from where it was
+  * @param entity Entity with a Transform
+  * @param x X location in pixels
+  * @param y Y location in pixels
+  */
+ void SetLocation(Entity entity, double x, double y)
+ {
+  auto &r = mRecords[entity];
+  r.table->x[r.row] = r.table->prevX[r.row] = x;
+  r.table->y[r.row] = r.table->prevY[r.row] = y;
+ }
+
+ /**
+  * X location to draw an entity at
+  * @param entity Entity with a Transform
+  * @return X location in pixels, between the last two updates
+  */
+ double GetDrawX(Entity entity) const
+ {
+  auto &r = mRecords[entity];
+  return r.table->prevX[r.row] + (r.table->x[r.row] - r.table->prevX[r.row]) * mInterpolation;
+ }
+
+ /**
+  * Y location to draw an entity at
+  * @param entity Entity with a Transform
+  * @return Y location in pixels, between the last two updates
+  */
+ double GetDrawY(Entity entity) const
+ {
+  auto &r = mRecords[entity];
+  return r.table->prevY[r.row] + (r.table->y[r.row] - r.table->prevY[r.row]) * mInterpolation;
+ }
+
+ /**
+  * Is an entity drawn mirrored?
+  * @param entity Entity with a Transform
+  * @return True if mirrored
+  */
+ bool GetMirror(Entity entity) const { auto &r = mRecords[entity]; return r.table->mirror[r.row] != 0; }
+
+ /**
+  * Set the mirror flag of an entity
+  * @param entity Entity with a Transform
+  * @param mirror True to draw mirrored
+  */
+ void SetMirror(Entity entity, bool mirror) { auto &r = mRecords[entity]; r.table->mirror[r.row] = mirror ? 1 : 0; }
+
+ /**
+  * X speed of an entity
+  * @param entity Entity with a Velocity
+  * @return Speed in pixels per second
+  */
+ double GetSpeedX(Entity entity) const { auto &r = mRecords[entity]; return r.table->speedX[r.row]; }
+
+ /**
+  * Y speed of an entity
+  * @param entity Entity with a Velocity
+  * @return Speed in pixels per second
+  */
+ double GetSpeedY(Entity entity) const { auto &r = mRecords[entity]; return r.table->speedY[r.row]; }
+
+ /**
+  * Set the speed of an entity
+  * @param entity Entity with a Velocity
+  * @param speedX X speed in pixels per second
+  * @param speedY Y speed in pixels per second
+  */
+ void SetSpeed(Entity entity, double speedX, double speedY)
+ {
+  auto &r = mRecords[entity];
+  r.table->speedX[r.row] = speedX;
+  r.table->speedY[r.row] = speedY;
+ }
+
+ /**
+  * Set the sprite size of an entity
+  * @param entity Entity with a Sprite
+  * @param halfWidth Half the sprite width
+  * @param halfHeight Half the sprite height
+  */
+ void SetHalfSize(Entity entity, double halfWidth, double halfHeight)
+ {
+  auto &r = mRecords[entity];
+  r.table->halfWidth[r.row] = halfWidth;
+  r.table->halfHeight[r.row] = halfHeight;
+ }
+
+ /**
+  * Species of a fish
+  * @param entity Entity with a School
+  * @return The species, which it schools with
+  */
+ FishSpecies GetSpecies(Entity entity) const { auto &r = mRecords[entity]; return (FishSpecies)r.table->species[r.row]; }
+
+ /**
+  * Set the species of a fish
+  * @param entity Entity with a School
+  * @param species The species, which it schools with
+  */
+ void SetSpecies(Entity entity, FishSpecies species) { auto &r = mRecords[entity]; r.table->species[r.row] = (uint8_t)species; }
+
+ /**
+  * Type name an entity is saved under
+  * @param entity Entity with a Persist
+  * @return The name or null if it has none
+  */
+ const wchar_t *GetType(Entity entity) const { auto &r = mRecords[entity]; return r.table->type[r.row]; }
+
+ /**
+  * Set the type name an entity is saved under
+  * @param entity Entity with a Persist
+  * @param type The name, a string that is never freed such as a literal
+  */
+ void SetType(Entity entity, const wchar_t *type) { auto &r = mRecords[entity]; r.table->type[r.row] = type; }
+};
+
+#endif //AQUARIUM_ITEMWORLD_H
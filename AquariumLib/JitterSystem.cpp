@@ -0,0 +1,48 @@
+/**
+ * @file JitterSystem.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the JitterSystem class.
+ */
+
+#include "pch.h"
+#include "JitterSystem.h"
+#include "CounterRandom.h"
+
+using namespace std;
+
+/// Seconds between vertical speed changes
+const double JitterInterval = 1.0;
+
+/// How much a vertical speed change adds or removes in pixels per second
+const double JitterSpeed = 5;
+
+/**
+ * Give rows whose timer has run out a random vertical speed change
+ * @param table Table of jittering entities
+ * @param begin First row to do
+ * @param end One past the last row to do
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+void JitterSystem::Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height)
+{
+ auto jitterTime = table.jitterTime.data();
+ auto speedY = table.speedY.data();
+ auto stream = table.stream.data();
+ auto draws = table.draws.data();
+
+ for (size_t i = begin; i < end; i++)
+ {
+  auto time = jitterTime[i] + elapsed;
+  if (time > JitterInterval)
+  {
+   time = 0;
+   auto bits = CounterRandom::Get(stream[i], draws[i]++);
+   speedY[i] += ((bits & 1) == 0 ? JitterSpeed : -JitterSpeed);
+  }
+
+  jitterTime[i] = time;
+ }
+}
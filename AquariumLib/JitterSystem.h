@@ -0,0 +1,40 @@
+/**
+ * @file JitterSystem.h
+ * @author Yeji Lee
+ *
+ * Declaration of the JitterSystem class.
+ *
+ * Gives fish a small random change of vertical speed now and then.
+ */
+
+#ifndef AQUARIUM_JITTERSYSTEM_H
+#define AQUARIUM_JITTERSYSTEM_H
+
+#include "ItemSystem.h"
+
+/**
+ * Changes the vertical speed of every entity with a Velocity
+ * and Jitter once a second.
+ *
+ * Each entity has its own timer and its own random stream (see
+ * CounterRandom), so entities never share state and can be
+ * updated on any thread in any order.
+ */
+class JitterSystem : public ItemSystem {
+public:
+ /**
+  * The components an entity needs to jitter
+  * @return Velocity and Jitter
+  */
+ ComponentMask GetComponents() const override { return Component::Velocity | Component::Jitter; }
+
+ /**
+  * Each entity jitters from its own random stream
+  * @return true
+  */
+ bool IsRowLocal() const override { return true; }
+
+ void Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height) override;
+};
+
+#endif //AQUARIUM_JITTERSYSTEM_H
@@ -0,0 +1,233 @@
+/**
+ * @file Log.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the Log class.
+ */
+
+#include "pch.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+/// How often the background thread empties the ring
+const chrono::milliseconds DrainPeriod(20);
+
+/**
+ * Get the process-wide log
+ * @return Reference to the one and only log
+ */
+Log &Log::Instance()
+{
+ static Log log;
+ return log;
+}
+
+/**
+ * Constructor, logs to standard error
+ */
+Log::Log() : mEntries(new Entry[Capacity])
+{
+ for (size_t i = 0; i < Capacity; i++)
+ {
+  mEntries[i].sequence.store(i, memory_order_relaxed);
+ }
+
+ mSink = [](const string &text) {
+  fwrite(text.data(), 1, text.size(), stderr);
+  fflush(stderr);
+ };
+}
+
+/**
+ * Destructor, stops the background thread and hands over
+ * whatever is left
+ */
+Log::~Log()
+{
+ {
+  lock_guard<mutex> lock(mMutex);
+  mStop = true;
+ }
+
+ mWake.notify_one();
+ if (mThread.joinable())
+ {
+  mThread.join();
+ }
+
+ Flush();
+}
+
+/**
+ * Set the least level that is logged.
+ *
+ * Turning the log on the first time starts the background thread.
+ *
+ * @param level The level, Level::Off to log nothing
+ */
+void Log::SetLevel(Level level)
+{
+ if (level != Level::Off)
+ {
+  call_once(mStarted, [this]() { mThread = thread(&Log::Run, this); });
+ }
+
+ mLevel.store(int(level), memory_order_relaxed);
+}
+
+/**
+ * Set where the log text goes.
+ *
+ * Whatever is in the ring goes to the old sink first.
+ *
+ * @param sink The sink, nullptr to throw the text away
+ */
+void Log::SetSink(Sink sink)
+{
+ lock_guard<mutex> lock(mMutex);
+ Drain();
+ mSink = std::move(sink);
+}
+
+/**
+ * Log a message.
+ *
+ * Use AQUARIUM_LOG rather than calling this, so messages that
+ * are off are never formatted. Never waits: if the ring is full
+ * the message is dropped.
+ *
+ * @param level Level of the message
+ * @param message The message, without a newline
+ */
+void Log::Write(Level level, const std::string &message)
+{
+ if (!IsEnabled(level))
+ {
+  return;
+ }
+
+ // Claim the entry at the tail, unless it has not been taken out yet
+ auto position = mTail.load(memory_order_relaxed);
+ Entry *entry;
+ for (;;)
+ {
+  entry = &mEntries[position & (Capacity - 1)];
+  auto sequence = entry->sequence.load(memory_order_acquire);
+  auto difference = int64_t(sequence - position);
+  if (difference == 0)
+  {
+   if (mTail.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+   {
+    break;
+   }
+  }
+  else if (difference < 0)
+  {
+   mDropped.fetch_add(1, memory_order_relaxed);
+   return;
+  }
+  else
+  {
+   position = mTail.load(memory_order_relaxed);
+  }
+ }
+
+ entry->level = level;
+ entry->length = uint32_t(min(message.size(), MessageSize));
+ memcpy(entry->text, message.data(), entry->length);
+ entry->sequence.store(position + 1, memory_order_release);
+}
+
+/**
+ * Hand everything in the ring to the sink now
+ */
+void Log::Flush()
+{
+ lock_guard<mutex> lock(mMutex);
+ Drain();
+}
+
+/**
+ * Empty the ring into the sink every so often until stopped
+ */
+void Log::Run()
+{
+ unique_lock<mutex> lock(mMutex);
+ while (!mStop)
+ {
+  mWake.wait_for(lock, DrainPeriod, [this]() { return mStop; });
+  Drain();
+ }
+}
+
+/**
+ * Take the messages out of the ring, in order, up to the first one
+ * still being written, and hand them to the sink in one piece.
+ *
+ * Only call with mMutex held.
+ */
+void Log::Drain()
+{
+ string text;
+ for (;;)
+ {
+  auto &entry = mEntries[mHead & (Capacity - 1)];
+  if (entry.sequence.load(memory_order_acquire) != mHead + 1)
+  {
+   break;
+  }
+
+  text += '[';
+  text += GetName(entry.level);
+  text += "] ";
+  text.append(entry.text, entry.length);
+  text += '\n';
+
+  // Free the entry for the writer one lap ahead
+  entry.sequence.store(mHead + Capacity, memory_order_release);
+  mHead++;
+ }
+
+ auto dropped = mDropped.load(memory_order_relaxed);
+ if (dropped != mReported)
+ {
+  text += "[warning] " + to_string(dropped - mReported) + " log messages dropped\n";
+  mReported = dropped;
+ }
+
+ if (!text.empty() && mSink != nullptr)
+ {
+  mSink(text);
+ }
+}
+
+/**
+ * Get the name a level is written with
+ * @param level The level
+ * @return Name of the level, such as "debug"
+ */
+const char *Log::GetName(Level level)
+{
+ switch (level)
+ {
+ case Level::Debug:
+  return "debug";
+
+ case Level::Info:
+  return "info";
+
+ case Level::Warning:
+  return "warning";
+
+ case Level::Error:
+  return "error";
+
+ default:
+  return "off";
+ }
+}
@@ -0,0 +1,195 @@
+/**
+ * @file Log.h
+ * @author Yeji Lee
+ *
+ * Declaration of the Log class and the AQUARIUM_LOG macro.
+ *
+ * Leveled diagnostics that any thread can write without waiting,
+ * and that cost one comparison while they are off, which they are
+ * unless someone turns them on.
+ */
+
+#ifndef AQUARIUM_LOG_H
+#define AQUARIUM_LOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/**
+ * Least level AQUARIUM_LOG statements are compiled in for, as an int.
+ *
+ * Debug messages (0) are only compiled into debug builds, release
+ * builds start at Info (1). Define it to override.
+ */
+#ifndef AQUARIUM_LOG_COMPILED_LEVEL
+#ifdef NDEBUG
+#define AQUARIUM_LOG_COMPILED_LEVEL 1
+#else
+#define AQUARIUM_LOG_COMPILED_LEVEL 0
+#endif
+#endif
+
+/**
+ * Process-wide diagnostic log.
+ *
+ * Messages below the level are dropped before they are formatted
+ * (see AQUARIUM_LOG). Messages that get through are copied into a
+ * ring of fixed size entries, claimed by a compare and swap, so any
+ * number of threads, simulation workers included, can log at once
+ * without a lock and without waiting on I/O. If the ring is full the
+ * message is dropped and counted instead.
+ *
+ * A background thread, started when the log is first turned on,
+ * takes what is in the ring every so often and hands it to the sink
+ * in one piece. The sink is only ever called by one thread at a time.
+ */
+class Log {
+public:
+ /// How much a message matters, from least to most
+ enum class Level {
+  Debug,      ///< Details for finding bugs
+  Info,       ///< Things worth knowing happened
+  Warning,    ///< Something went wrong but we carried on
+  Error,      ///< Something the user asked for failed
+  Off         ///< Above every message, for turning the log off
+ };
+
+ /// Where the log text goes, handed whole lines
+ typedef std::function<void(const std::string &text)> Sink;
+
+ /// Number of entries in the ring, a power of two
+ static constexpr size_t Capacity = 4096;
+
+ /// Longest message kept in bytes, longer ones are cut short
+ static constexpr size_t MessageSize = 240;
+
+ /// Least level compiled in
+ static constexpr Level CompiledLevel = Level(AQUARIUM_LOG_COMPILED_LEVEL);
+
+private:
+ /// A message in the ring
+ struct Entry
+ {
+  /// Position this entry is free to write at, or that plus one once written
+  std::atomic<uint64_t> sequence;
+
+  /// Level of the message
+  Level level;
+
+  /// Length of the message
+  uint32_t length;
+
+  /// The message, not null terminated
+  char text[MessageSize];
+ };
+
+ /// Messages below this level are dropped
+ std::atomic<int> mLevel{int(Level::Off)};
+
+ /// The ring
+ std::unique_ptr<Entry[]> mEntries;
+
+ /// Count of messages taken out of the ring, under mMutex
+ uint64_t mHead = 0;
+
+ /// Count of entries claimed by writers
+ alignas(64) std::atomic<uint64_t> mTail{0};
+
+ /// Count of messages dropped because the ring was full
+ alignas(64) std::atomic<uint64_t> mDropped{0};
+
+ /// Count of dropped messages already reported, under mMutex
+ uint64_t mReported = 0;
+
+ /// Taken by whoever empties the ring, protects everything below
+ std::mutex mMutex;
+
+ /// Where the lines go
+ Sink mSink;
+
+ /// Wakes the background thread early to stop
+ std::condition_variable mWake;
+
+ /// Set to stop the background thread
+ bool mStop = false;
+
+ /// Starts the background thread once
+ std::once_flag mStarted;
+
+ /// The background thread
+ std::thread mThread;
+
+ /// Constructor, use Instance() instead
+ Log();
+
+ void Run();
+ void Drain();
+
+public:
+ ~Log();
+
+ /// Copy constructor (disabled)
+ Log(const Log &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const Log &) = delete;
+
+ static Log &Instance();
+
+ /**
+  * Would a message at a level be logged?
+  * @param level Level of the message
+  * @return true if it would
+  */
+ bool IsEnabled(Level level) const { return int(level) >= mLevel.load(std::memory_order_relaxed); }
+
+ void SetLevel(Level level);
+
+ /**
+  * Get the least level that is logged
+  * @return The level
+  */
+ Level GetLevel() const { return Level(mLevel.load(std::memory_order_relaxed)); }
+
+ /**
+  * Get how many messages were dropped because the ring was full
+  * @return Count of dropped messages since the program started
+  */
+ uint64_t GetDropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+ void SetSink(Sink sink);
+ void Write(Level level, const std::string &message);
+ void Flush();
+
+ static const char *GetName(Level level);
+};
+
+/**
+ * Log a message if its level is on.
+ *
+ * The message is anything that can be written to a stream, such
+ * as "Item added at " << x << ", " << y, and is only formatted if
+ * the level is on. Statements below AQUARIUM_LOG_COMPILED_LEVEL
+ * are compiled out altogether.
+ *
+ * @param level A Log::Level
+ * @param message What to write
+ */
+#define AQUARIUM_LOG(level, message) \
+    do { \
+     if ((level) >= Log::CompiledLevel && Log::Instance().IsEnabled(level)) \
+     { \
+      std::ostringstream aquariumLogStream_; \
+      aquariumLogStream_ << message; \
+      Log::Instance().Write(level, aquariumLogStream_.str()); \
+     } \
+    } while (false)
+
+#endif //AQUARIUM_LOG_H
@@ -29,11 +29,11 @@ void MainFrame::Initialize()
  auto sizer = new wxBoxSizer(wxVERTICAL);
 
  // Create the Aquarium object as a child of MainFrame
- auto aquariumView = new AquariumView();
- aquariumView->Initialize(this);
+ mView = new AquariumView();
+ mView->Initialize(this);
 
  // Add the aquarium view to the sizer and allow it to expand
- sizer->Add(aquariumView,1, wxEXPAND | wxALL );
+ sizer->Add(mView,1, wxEXPAND | wxALL );
 
  // Set the sizer for this frame, allowing it to manage child window layout
  SetSizer( sizer );
@@ -56,11 +56,16 @@ void MainFrame::Initialize()
  fileMenu->Append(wxID_EXIT, "E&xit\tAlt-X", "Quit this program");
  fileMenu->Append(wxID_SAVEAS, "Save &As...\tCtrl-S", L"Save aquarium as...");
  fileMenu->Append(wxID_OPEN, "Open &File...\tCtrl-F", L"Open aquarium file...");
+ fileMenu->AppendSeparator();
+ fileMenu->Append(IDM_RECORD, L"&Record Session...", L"Record everything that happens to a session file");
+ fileMenu->Append(IDM_STOPRECORDING, L"S&top Recording", L"Stop recording the session");
  helpMenu->Append(wxID_ABOUT, "&About\tF1", "Show about dialog");
  fishMenu->Append(IDM_ADDFISHBETA, L"&Beta Fish", L"Add a Beta Fish");
  fishMenu->Append(IDM_ADDFISHNEMO, L"&Nemo Fish", L"Add a Nemo Fish");
  fishMenu->Append(IDM_ADDFISHDORY, L"&Dory Fish", L"Add a Dory Fish");
  fishMenu->Append(IDM_ADDDECORCASTLE, L"&Decor Castle", L"Add a decor Castle");
+ fishMenu->AppendSeparator();
+ fishMenu->AppendCheckItem(IDM_SCHOOLING, L"&Schooling", L"Fish swim in schools");
 
  SetMenuBar( menuBar );
 
@@ -72,6 +77,16 @@ void MainFrame::Initialize()
  CreateStatusBar( 1, wxSTB_SIZEGRIP, wxID_ANY );
 }
 
+/**
+ * Start the simulation in the aquarium view.
+ *
+ * Call once every sprite the simulation may ask for has been made.
+ */
+void MainFrame::StartSimulation()
+{
+ mView->StartSimulation();
+}
+
 /**
  * Exit menu option handlers
  * @param event wxCommandEvent triggered by selectring "Exit" option
@@ -14,6 +14,8 @@
 
 #include <wx/wx.h>
 
+class AquariumView;
+
 /**
  * @class MainFrame
  * The top-level frame of the application.
@@ -25,11 +27,15 @@
  */
 class MainFrame : public wxFrame {
 private:
+ /// The view showing the aquarium
+ AquariumView *mView = nullptr;
 
 public:
 
  void Initialize();
 
+ void StartSimulation();
+
 
  void OnExit(wxCommandEvent& event);
 
@@ -0,0 +1,39 @@
+/**
+ * @file MotionSystem.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the MotionSystem class.
+ */
+
+#include "pch.h"
+#include "MotionSystem.h"
+#include <cstring>
+
+using namespace std;
+
+/**
+ * Save the locations of some rows and move them
+ * @param table Table of moving entities
+ * @param begin First row to do
+ * @param end One past the last row to do
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+void MotionSystem::Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height)
+{
+ FishBatch batch;
+ batch.x = table.x.data() + begin;
+ batch.y = table.y.data() + begin;
+ batch.speedX = table.speedX.data() + begin;
+ batch.speedY = table.speedY.data() + begin;
+ batch.halfWidth = table.halfWidth.data() + begin;
+ batch.halfHeight = table.halfHeight.data() + begin;
+ batch.mirror = table.mirror.data() + begin;
+ batch.count = end - begin;
+
+ memcpy(table.prevX.data() + begin, batch.x, batch.count * sizeof(double));
+ memcpy(table.prevY.data() + begin, batch.y, batch.count * sizeof(double));
+
+ FishKernel::Move(mKernel, batch, elapsed, width, height);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file MotionSystem.h
+ * @author Yeji Lee
+ *
+ * Declaration of the MotionSystem class.
+ *
+ * Moves entities with their speed and bounces them off the walls.
+ */
+
+#ifndef AQUARIUM_MOTIONSYSTEM_H
+#define AQUARIUM_MOTIONSYSTEM_H
+
+#include "ItemSystem.h"
+#include "FishKernel.h"
+
+/**
+ * Moves every entity with a Transform, Velocity and Sprite.
+ *
+ * The locations are saved first so entities can be drawn between
+ * them and the new ones, then a FishKernel does the moving,
+ * several entities at a time when the processor allows it.
+ */
+class MotionSystem : public ItemSystem {
+private:
+ /// Kernel that does the moving
+ FishKernel::Level mKernel = FishKernel::GetBestLevel();
+
+public:
+ /**
+  * The components an entity needs to be moved
+  * @return Transform, Velocity and Sprite
+  */
+ ComponentMask GetComponents() const override { return Component::Transform | Component::Velocity | Component::Sprite; }
+
+ /**
+  * Each entity moves and bounces on its own
+  * @return true
+  */
+ bool IsRowLocal() const override { return true; }
+
+ void Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height) override;
+
+ /**
+  * Choose the kernel that does the moving, for comparing them
+  * @param kernel Kernel level, falls back to scalar if unsupported
+  */
+ void SetKernel(FishKernel::Level kernel) { mKernel = kernel; }
+};
+
+#endif //AQUARIUM_MOTIONSYSTEM_H
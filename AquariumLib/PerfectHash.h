@@ -0,0 +1,197 @@
+/**
+ * @file PerfectHash.h
+ * @author Yeji Lee
+ *
+ * Declaration of the PerfectHash class template.
+ *
+ * A hash table over a fixed set of names, worked out by the
+ * compiler, in which no two names collide.
+ */
+
+#ifndef AQUARIUM_PERFECTHASH_H
+#define AQUARIUM_PERFECTHASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Perfect hash of a fixed set of names to their index in the set.
+ *
+ * Built by hash and displace: the names are spread over buckets
+ * by one hash, then each bucket, biggest first, gets the first seed
+ * for a second hash that puts all its names in free slots. A lookup
+ * is two hashes, one slot and one string compare to turn away names
+ * not in the set. Built as a constexpr, the search runs in the
+ * compiler and the table is plain data in the program.
+ *
+ * @tparam Count Number of names
+ */
+template <size_t Count>
+class PerfectHash {
+public:
+ /// Number of slots, a power of two at least twice the names
+ static constexpr size_t Size = [] {
+  size_t size = 2;
+  while (size < Count * 2)
+  {
+   size *= 2;
+  }
+  return size;
+ }();
+
+ /// Number of buckets, about two names to each
+ static constexpr size_t Buckets = Size / 4 > 0 ? Size / 4 : 1;
+
+ /// Slot that holds no name
+ static constexpr uint8_t Empty = UINT8_MAX;
+
+ static_assert(Count < Empty, "Too many names for a PerfectHash");
+
+private:
+ /// Most seeds tried for one bucket
+ static constexpr uint32_t MaxSeed = 100000;
+
+ /// The names, by index
+ std::array<const wchar_t *, Count> mNames{};
+
+ /// Index of the name in each slot, or Empty
+ std::array<uint8_t, Size> mSlots{};
+
+ /// Seed of the second hash for each bucket
+ std::array<uint32_t, Buckets> mSeeds{};
+
+ /// False if some bucket found no seed
+ bool mPerfect = true;
+
+ /**
+  * Hash a name
+  * @param name The name, null terminated
+  * @param seed Seed to hash with
+  * @return The hash
+  */
+ static constexpr uint32_t Hash(const wchar_t *name, uint32_t seed)
+ {
+  uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (; *name != 0; name++)
+  {
+   hash = (hash ^ uint32_t(*name)) * 16777619u;
+  }
+
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  return hash ^ (hash >> 13);
+ }
+
+ /**
+  * Are two names the same?
+  * @param a A name
+  * @param b Another name
+  * @return true if they are
+  */
+ static constexpr bool Equal(const wchar_t *a, const wchar_t *b)
+ {
+  for (; *a != 0 && *a == *b; a++, b++)
+  {
+  }
+
+  return *a == *b;
+ }
+
+ /**
+  * Find a seed that puts every name of a bucket in a free slot,
+  * and put them there
+  * @param bucket The bucket
+  * @return false if there is no such seed
+  */
+ constexpr bool Place(size_t bucket)
+ {
+  for (uint32_t seed = 1; seed < MaxSeed; seed++)
+  {
+   std::array<size_t, Count> taken{};
+   size_t placed = 0;
+   bool fits = true;
+   for (size_t i = 0; i < Count && fits; i++)
+   {
+    if ((Hash(mNames[i], 0) & (Buckets - 1)) != bucket)
+    {
+     continue;
+    }
+
+    // Names of this bucket already placed count as taken too
+    auto slot = Hash(mNames[i], seed) & (Size - 1);
+    fits = mSlots[slot] == Empty;
+    if (fits)
+    {
+     mSlots[slot] = uint8_t(i);
+     taken[placed++] = slot;
+    }
+   }
+
+   if (fits)
+   {
+    mSeeds[bucket] = seed;
+    return true;
+   }
+
+   // Take back what this seed placed
+   for (size_t j = 0; j < placed; j++)
+   {
+    mSlots[taken[j]] = Empty;
+   }
+  }
+
+  return false;
+ }
+
+public:
+ /**
+  * Constructor, finds the seeds
+  * @param names The names, all different
+  */
+ constexpr PerfectHash(const std::array<const wchar_t *, Count> &names) : mNames(names)
+ {
+  for (auto &slot : mSlots)
+  {
+   slot = Empty;
+  }
+
+  std::array<size_t, Buckets> sizes{};
+  for (auto name : mNames)
+  {
+   sizes[Hash(name, 0) & (Buckets - 1)]++;
+  }
+
+  // Biggest buckets first, while there is the most room
+  for (auto size = Count; size > 0 && mPerfect; size--)
+  {
+   for (size_t bucket = 0; bucket < Buckets && mPerfect; bucket++)
+   {
+    if (sizes[bucket] == size)
+    {
+     mPerfect = Place(bucket);
+    }
+   }
+  }
+ }
+
+ /**
+  * Find the index of a name
+  * @param name The name, null terminated
+  * @return Index of the name, or -1 if it is not one of them
+  */
+ constexpr int Find(const wchar_t *name) const
+ {
+  auto seed = mSeeds[Hash(name, 0) & (Buckets - 1)];
+  auto index = mSlots[Hash(name, seed) & (Size - 1)];
+  return index != Empty && Equal(mNames[index], name) ? index : -1;
+ }
+
+ /**
+  * Did every name get a slot of its own?
+  * @return true if the hash is perfect
+  */
+ constexpr bool IsPerfect() const { return mPerfect; }
+};
+
+#endif //AQUARIUM_PERFECTHASH_H
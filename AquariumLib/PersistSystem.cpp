@@ -0,0 +1,65 @@
+/**
+ * @file PersistSystem.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the PersistSystem class.
+ */
+
+#include "pch.h"
+#include "PersistSystem.h"
+#include <wx/xml/xml.h>
+
+using namespace std;
+
+/**
+ * Save an entity as a new item node
+ * @param world World holding the entity
+ * @param entity Entity with a Transform
+ * @param parent The node the item node is made a child of
+ * @return The item node
+ */
+wxXmlNode *PersistSystem::Save(const ItemWorld &world, Entity entity, wxXmlNode *parent)
+{
+ auto itemNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"item");
+ parent->AddChild(itemNode);
+
+ itemNode->AddAttribute(L"x", wxString::FromDouble(world.GetX(entity)));
+ itemNode->AddAttribute(L"y", wxString::FromDouble(world.GetY(entity)));
+
+ if (world.Has(entity, Component::Velocity))
+ {
+  itemNode->AddAttribute(L"speedx", wxString::Format(L"%g", world.GetSpeedX(entity)));
+  itemNode->AddAttribute(L"speedy", wxString::Format(L"%g", world.GetSpeedY(entity)));
+ }
+
+ if (world.Has(entity, Component::Persist) && world.GetType(entity) != nullptr)
+ {
+  itemNode->AddAttribute(L"type", world.GetType(entity));
+ }
+
+ return itemNode;
+}
+
+/**
+ * Load an entity's location, and speed if it has one, from an
+ * item node. Attributes the node lacks leave the location at 0
+ * and the speed as it was.
+ * @param world World holding the entity
+ * @param entity Entity with a Transform
+ * @param node The item node
+ */
+void PersistSystem::Load(ItemWorld &world, Entity entity, wxXmlNode *node)
+{
+ double x = 0, y = 0;
+ node->GetAttribute(L"x", L"0").ToDouble(&x);
+ node->GetAttribute(L"y", L"0").ToDouble(&y);
+ world.SetLocation(entity, x, y);
+
+ if (world.Has(entity, Component::Velocity))
+ {
+  double speedX = world.GetSpeedX(entity), speedY = world.GetSpeedY(entity);
+  node->GetAttribute(L"speedx").ToDouble(&speedX);
+  node->GetAttribute(L"speedy").ToDouble(&speedY);
+  world.SetSpeed(entity, speedX, speedY);
+ }
+}
@@ -0,0 +1,31 @@
+/**
+ * @file PersistSystem.h
+ * @author Yeji Lee
+ *
+ * Declaration of the PersistSystem class.
+ *
+ * Saves entities to and loads them from .aqua XML item nodes.
+ */
+
+#ifndef AQUARIUM_PERSISTSYSTEM_H
+#define AQUARIUM_PERSISTSYSTEM_H
+
+#include "ItemWorld.h"
+
+class wxXmlNode;
+
+/**
+ * Turns an entity's components into the attributes of an item
+ * node and back.
+ *
+ * Every item saves its location, anything with a Velocity its
+ * speed and anything with a Persist type name its type, which is
+ * what Aquarium::Create makes it from again.
+ */
+class PersistSystem {
+public:
+ static wxXmlNode *Save(const ItemWorld &world, Entity entity, wxXmlNode *parent);
+ static void Load(ItemWorld &world, Entity entity, wxXmlNode *node);
+};
+
+#endif //AQUARIUM_PERSISTSYSTEM_H
@@ -0,0 +1,172 @@
+/**
+ * @file PopulationGenerator.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the PopulationGenerator class.
+ */
+
+#include "pch.h"
+#include "PopulationGenerator.h"
+#include "Aquarium.h"
+#include "CounterRandom.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+/// Closest to the edge of the tank an item is put in pixels, about half a fish
+const double Margin = 40;
+
+/// Fraction of the tank height at the bottom that decor sits in
+const double DecorBand = 0.25;
+
+/// Random draws used for each item
+const uint64_t DrawsPerItem = 4;
+
+/// Pi, for turning draws into angles
+const double Pi = 3.14159265358979323846;
+
+/**
+ * Turn random bits into a double
+ * @param bits 64 random bits
+ * @return Number from 0 up to but not including 1
+ */
+static double ToUnit(uint64_t bits)
+{
+ return double(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Constructor
+ * @param seed Seed every choice follows from
+ */
+PopulationGenerator::PopulationGenerator(uint64_t seed) : mSeed(seed)
+{
+}
+
+/**
+ * Set the weight of a species in the mix
+ * @param type Type name of the species, such as L"beta"
+ * @param weight Weight relative to the others, 0 to leave it out
+ */
+void PopulationGenerator::SetMix(const std::wstring &type, double weight)
+{
+ for (auto &species : mMix)
+ {
+  if (species.first == type)
+  {
+   species.second = weight;
+   return;
+  }
+ }
+
+ mMix.emplace_back(type, weight);
+}
+
+/**
+ * Make the population and add it to an aquarium, in front of
+ * anything already there
+ * @param aquarium The aquarium
+ * @return Number of items added
+ */
+size_t PopulationGenerator::Generate(Aquarium &aquarium) const
+{
+ double width = aquarium.GetWidth();
+ double height = aquarium.GetHeight();
+ auto key = CounterRandom::Key(mSeed, 0);
+ auto draw = [key](uint64_t item, uint64_t which) {
+  return ToUnit(CounterRandom::Get(key, item * DrawsPerItem + which));
+ };
+ auto clampX = [width](double x) { return max(Margin, min(width - Margin, x)); };
+ auto clampY = [height](double y) { return max(Margin, min(height - Margin, y)); };
+
+ // Running totals of the weights, to pick species by
+ vector<double> cumulative;
+ double total = 0;
+ for (auto &species : mMix)
+ {
+  total += max(0.0, species.second);
+  cumulative.push_back(total);
+ }
+
+ auto decor = size_t(double(mCount) * min(1.0, max(0.0, mDecorDensity)) + 0.5);
+ auto fish = total > 0 ? mCount - decor : 0;
+
+ // Centers of the schools, from a stream of their own
+ auto schoolKey = CounterRandom::Key(mSeed, 1);
+ vector<pair<double, double>> schools;
+ for (int s = 0; s < mSchools; s++)
+ {
+  schools.emplace_back(Margin + ToUnit(CounterRandom::Get(schoolKey, s * 2)) * (width - 2 * Margin),
+                       Margin + ToUnit(CounterRandom::Get(schoolKey, s * 2 + 1)) * (height - 2 * Margin));
+ }
+
+ auto &world = *aquarium.GetWorld();
+ world.Reserve(Component::Item, world.GetCount(Component::Item) - world.GetCount(Component::Fish) + decor);
+ aquarium.GetFishStore().Reserve(aquarium.GetFishStore().GetCount() + fish);
+
+ vector<shared_ptr<Item>> items;
+ items.reserve(decor + fish);
+
+ // Decor first, so it is behind the fish
+ for (uint64_t i = 0; i < decor; i++)
+ {
+  auto item = aquarium.Create(mDecorType);
+  if (item == nullptr)
+  {
+   break;
+  }
+
+  auto top = height * (1 - DecorBand);
+  item->SetLocation(clampX(draw(i, 0) * width), clampY(top + draw(i, 1) * (height - top)));
+  items.push_back(std::move(item));
+ }
+
+ for (uint64_t i = decor; i < decor + fish; i++)
+ {
+  auto pick = draw(i, 0) * total;
+  auto species = size_t(upper_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin());
+  species = min(species, mMix.size() - 1);
+
+  auto item = aquarium.Create(mMix[species].first);
+  if (item == nullptr)
+  {
+   continue;
+  }
+
+  double x = 0, y = 0;
+  switch (mLayout)
+  {
+  case Layout::Uniform:
+   x = draw(i, 1) * width;
+   y = draw(i, 2) * height;
+   break;
+
+  case Layout::Schools:
+  {
+   // Box-Muller, a normally distributed offset from the school's center
+   auto &center = schools[min(size_t(draw(i, 1) * schools.size()), schools.size() - 1)];
+   auto radius = sqrt(-2 * log(1 - draw(i, 2))) * mSpread;
+   auto angle = 2 * Pi * draw(i, 3);
+   x = center.first + radius * cos(angle);
+   y = center.second + radius * sin(angle);
+   break;
+  }
+
+  case Layout::Layers:
+  {
+   auto band = (height - 2 * Margin) / double(mMix.size());
+   x = draw(i, 1) * width;
+   y = Margin + (double(species) + draw(i, 2)) * band;
+   break;
+  }
+  }
+
+  item->SetLocation(clampX(x), clampY(y));
+  items.push_back(std::move(item));
+ }
+
+ auto added = items.size();
+ aquarium.AddMany(std::move(items));
+ return added;
+}
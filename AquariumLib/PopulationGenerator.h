@@ -0,0 +1,105 @@
+/**
+ * @file PopulationGenerator.h
+ * @author Yeji Lee
+ *
+ * Declaration of the PopulationGenerator class.
+ *
+ * Fills a tank with as many items as a stress scenario needs,
+ * the same way every time for the same seed.
+ */
+
+#ifndef AQUARIUM_POPULATIONGENERATOR_H
+#define AQUARIUM_POPULATIONGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Aquarium;
+
+/**
+ * Seeded generator of aquarium populations.
+ *
+ * Makes a number of items, some fraction of them decor along the
+ * bottom and the rest fish picked by weight from a species mix and
+ * spread over the tank by a Layout. Every choice for an item is a
+ * CounterRandom draw keyed by the seed and the item's number, so the
+ * same settings give the same tank.
+ *
+ * The items are made in the aquarium's arena, the world is made
+ * room for once, and they all go into the aquarium in one pass at
+ * the end, so millions of items cost no more than their construction.
+ * Fish speeds come from the aquarium's random numbers as usual, so
+ * restart the aquarium from a seed too for a tank that is the same
+ * down to the speeds.
+ */
+class PopulationGenerator {
+public:
+ /// How the fish are spread over the tank
+ enum class Layout {
+  Uniform,    ///< Anywhere, with equal chance
+  Schools,    ///< Normally distributed around a number of centers
+  Layers      ///< Each species in a horizontal band of its own
+ };
+
+private:
+ /// Seed every choice follows from
+ uint64_t mSeed;
+
+ /// Number of items, decor included
+ size_t mCount = 1000;
+
+ /// Type names of the species and their weights
+ std::vector<std::pair<std::wstring, double>> mMix = {{L"beta", 1}, {L"nemo", 1}, {L"dory", 1}};
+
+ /// How the fish are spread
+ Layout mLayout = Layout::Uniform;
+
+ /// Number of schools for Layout::Schools
+ int mSchools = 16;
+
+ /// Standard deviation of a school around its center in pixels
+ double mSpread = 60;
+
+ /// Fraction of the items that are decor
+ double mDecorDensity = 0.001;
+
+ /// Type name of the decor
+ std::wstring mDecorType = L"castle";
+
+public:
+ explicit PopulationGenerator(uint64_t seed);
+
+ /**
+  * Set how many items to make
+  * @param count Number of items, decor included
+  */
+ void SetCount(size_t count) { mCount = count; }
+
+ void SetMix(const std::wstring &type, double weight);
+
+ /**
+  * Set how the fish are spread over the tank
+  * @param layout The layout
+  */
+ void SetLayout(Layout layout) { mLayout = layout; }
+
+ /**
+  * Set the schools fish gather in for Layout::Schools
+  * @param count Number of schools
+  * @param spread Standard deviation of a school around its center in pixels
+  */
+ void SetSchools(int count, double spread) { mSchools = count > 0 ? count : 1; mSpread = spread; }
+
+ /**
+  * Set how much of the population is decor
+  * @param density Fraction of the items that are decor, from 0 to 1
+  * @param type Type name of the decor
+  */
+ void SetDecorDensity(double density, const std::wstring &type = L"castle") { mDecorDensity = density; mDecorType = type; }
+
+ size_t Generate(Aquarium &aquarium) const;
+};
+
+#endif //AQUARIUM_POPULATIONGENERATOR_H
@@ -0,0 +1,136 @@
+/**
+ * @file SchoolSystem.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SchoolSystem class.
+ */
+
+#include "pch.h"
+#include "SchoolSystem.h"
+#include "WorkerPool.h"
+#include <cstring>
+
+using namespace std;
+
+/**
+ * Work out the new speed of every schooling fish.
+ *
+ * The fish are filed into the schooling grid, then steered in
+ * chunks over the worker pool into separate arrays, so no fish
+ * sees a neighbor's speed change part way.
+ *
+ * @param world The world being updated
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ * @return false if schooling is off or there are no fish
+ */
+bool SchoolSystem::Prepare(ItemWorld &world, double elapsed, double width, double height)
+{
+ if (!mSchooling.IsEnabled())
+ {
+  return false;
+ }
+
+ mTables.clear();
+ size_t count = 0;
+ for (auto &table : world.GetTables())
+ {
+  if (table->Has(GetComponents()) && table->GetCount() > 0)
+  {
+   mTables.emplace_back(table.get(), count);
+   count += table->GetCount();
+  }
+ }
+
+ if (count == 0)
+ {
+  return false;
+ }
+
+ mNewSpeedX.resize(count);
+ mNewSpeedY.resize(count);
+
+ SchoolBatch batch;
+ batch.newSpeedX = mNewSpeedX.data();
+ batch.newSpeedY = mNewSpeedY.data();
+
+ // Fish all in one table are steered where they are
+ mGathered = mTables.size() > 1;
+ if (!mGathered)
+ {
+  auto table = mTables[0].first;
+  batch.x = table->x.data();
+  batch.y = table->y.data();
+  batch.speedX = table->speedX.data();
+  batch.speedY = table->speedY.data();
+  batch.species = table->species.data();
+  batch.mirror = table->mirror.data();
+ }
+ else
+ {
+  mX.resize(count);
+  mY.resize(count);
+  mSpeedX.resize(count);
+  mSpeedY.resize(count);
+  mSpecies.resize(count);
+  mMirror.resize(count);
+  for (auto &entry : mTables)
+  {
+   auto table = entry.first;
+   auto at = entry.second;
+   auto rows = table->GetCount();
+   memcpy(mX.data() + at, table->x.data(), rows * sizeof(double));
+   memcpy(mY.data() + at, table->y.data(), rows * sizeof(double));
+   memcpy(mSpeedX.data() + at, table->speedX.data(), rows * sizeof(double));
+   memcpy(mSpeedY.data() + at, table->speedY.data(), rows * sizeof(double));
+   memcpy(mSpecies.data() + at, table->species.data(), rows);
+   memcpy(mMirror.data() + at, table->mirror.data(), rows);
+  }
+
+  batch.x = mX.data();
+  batch.y = mY.data();
+  batch.speedX = mSpeedX.data();
+  batch.speedY = mSpeedY.data();
+  batch.species = mSpecies.data();
+  batch.mirror = mMirror.data();
+ }
+
+ mSchooling.Build(batch.x, batch.y, count, width, height);
+ auto &pool = world.GetWorkerPool();
+ pool.Run(count, GetChunk(count, pool.GetThreadCount()), [&](size_t begin, size_t end) {
+  mSchooling.Steer(batch, begin, end, elapsed);
+ });
+
+ return true;
+}
+
+/**
+ * Copy the new speeds of some rows over their speeds
+ * @param table Table of schooling fish
+ * @param begin First row to do
+ * @param end One past the last row to do
+ * @param elapsed Time since the last update in seconds
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+void SchoolSystem::Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height)
+{
+ size_t at = 0;
+ for (auto &entry : mTables)
+ {
+  if (entry.first == &table)
+  {
+   at = entry.second;
+   break;
+  }
+ }
+
+ auto rows = end - begin;
+ memcpy(table.speedX.data() + begin, mNewSpeedX.data() + at + begin, rows * sizeof(double));
+ memcpy(table.speedY.data() + begin, mNewSpeedY.data() + at + begin, rows * sizeof(double));
+ if (mGathered)
+ {
+  memcpy(table.mirror.data() + begin, mMirror.data() + at + begin, rows);
+ }
+}
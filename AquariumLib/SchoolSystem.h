@@ -0,0 +1,68 @@
+/**
+ * @file SchoolSystem.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SchoolSystem class.
+ *
+ * Steers fish in schools with their neighbors (see Schooling).
+ */
+
+#ifndef AQUARIUM_SCHOOLSYSTEM_H
+#define AQUARIUM_SCHOOLSYSTEM_H
+
+#include <utility>
+#include <vector>
+#include "ItemSystem.h"
+#include "Schooling.h"
+
+/**
+ * Steers every entity with a Transform, Velocity and School.
+ *
+ * Prepare works out the new speeds of every schooling fish at
+ * once, since a fish's neighbors may be in any table, and Run
+ * copies them over the speeds before the fish move. Fish in more
+ * than one table are gathered into one set of arrays first.
+ */
+class SchoolSystem : public ItemSystem {
+private:
+ /// Schooling settings and neighbor grid
+ Schooling mSchooling;
+
+ /// Tables of schooling fish this update, with where each starts in the arrays steered
+ std::vector<std::pair<ItemTable *, size_t>> mTables;
+
+ /// True if the fish were copied out of their tables to be steered
+ bool mGathered = false;
+
+ // Fish gathered from more than one table
+ std::vector<double> mX;             ///< X location of the fish center
+ std::vector<double> mY;             ///< Y location of the fish center
+ std::vector<double> mSpeedX;        ///< X speed in pixels per second
+ std::vector<double> mSpeedY;        ///< Y speed in pixels per second
+ std::vector<uint8_t> mSpecies;      ///< FishSpecies of the fish
+ std::vector<uint8_t> mMirror;       ///< Mirror flag, set by steering
+
+ /// Speeds worked out by steering
+ std::vector<double> mNewSpeedX;
+
+ /// Speeds worked out by steering
+ std::vector<double> mNewSpeedY;
+
+public:
+ /**
+  * The components an entity needs to school
+  * @return Transform, Velocity and School
+  */
+ ComponentMask GetComponents() const override { return Component::Transform | Component::Velocity | Component::School; }
+
+ bool Prepare(ItemWorld &world, double elapsed, double width, double height) override;
+ void Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height) override;
+
+ /**
+  * Get the schooling settings
+  * @return Reference to the schooling settings, off unless enabled
+  */
+ Schooling &GetSchooling() { return mSchooling; }
+};
+
+#endif //AQUARIUM_SCHOOLSYSTEM_H
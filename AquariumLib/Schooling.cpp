@@ -0,0 +1,191 @@
+/**
+ * @file Schooling.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the Schooling class.
+ */
+
+#include "pch.h"
+#include "Schooling.h"
+
+using namespace std;
+
+/**
+ * Constructor, schooling off with rules to suit each species
+ */
+Schooling::Schooling()
+{
+ // Fish that are not one of the species never school
+ mRules[(int)FishSpecies::None].enabled = false;
+
+ // Beta are big and keep their distance
+ auto &beta = mRules[(int)FishSpecies::Beta];
+ beta.separationDistance = 35;
+ beta.minSpeed = 40;
+ beta.maxSpeed = 140;
+
+ // Nemo are slow and stay close
+ auto &nemo = mRules[(int)FishSpecies::Nemo];
+ nemo.separationDistance = 20;
+ nemo.cohesion = 1.2;
+ nemo.minSpeed = 15;
+ nemo.maxSpeed = 45;
+
+ // Dory are fast and loosely grouped
+ auto &dory = mRules[(int)FishSpecies::Dory];
+ dory.alignment = 1;
+ dory.cohesion = 0.5;
+ dory.minSpeed = 100;
+ dory.maxSpeed = 280;
+}
+
+/**
+ * File the fish into the neighbor grid
+ * @param x X location of each fish
+ * @param y Y location of each fish
+ * @param count Number of fish
+ * @param width Width of the aquarium in pixels
+ * @param height Height of the aquarium in pixels
+ */
+void Schooling::Build(const double *x, const double *y, size_t count, double width, double height)
+{
+ if (width != mGridWidth || height != mGridHeight || mRadius != mGridCellSize)
+ {
+  mGridWidth = width;
+  mGridHeight = height;
+  mGridCellSize = mRadius;
+  mGrid.Resize(width, height, mRadius);
+ }
+
+ mGrid.Build(x, y, count);
+}
+
+/**
+ * Work out the new speeds of a range of fish.
+ *
+ * Fish that do not school keep their speed. The rest add up, over
+ * their neighbors, a push away from any that are too close and the
+ * speed and offset of those of their own species. The speed is then
+ * kept between the species' limits and the fish turned to face the
+ * way it swims.
+ *
+ * @param batch The fish
+ * @param begin First fish to steer
+ * @param end One past the last fish to steer
+ * @param elapsed Time since the last update in seconds
+ */
+void Schooling::Steer(const SchoolBatch &batch, size_t begin, size_t end, double elapsed) const
+{
+ const auto radius2 = mRadius * mRadius;
+
+ for (size_t i = begin; i < end; i++)
+ {
+  auto speedX = batch.speedX[i];
+  auto speedY = batch.speedY[i];
+  auto species = batch.species[i];
+  auto &rules = mRules[species];
+  if (!rules.enabled)
+  {
+   batch.newSpeedX[i] = speedX;
+   batch.newSpeedY[i] = speedY;
+   continue;
+  }
+
+  auto x = batch.x[i];
+  auto y = batch.y[i];
+  auto separation2 = rules.separationDistance * rules.separationDistance;
+
+  int seen = 0;
+  int same = 0;
+  double sumSpeedX = 0, sumSpeedY = 0;
+  double sumOffsetX = 0, sumOffsetY = 0;
+  double pushX = 0, pushY = 0;
+
+  auto visit = [&](int j, double jx, double jy) {
+   if (j == (int)i)
+   {
+    return true;
+   }
+
+   auto dx = jx - x;
+   auto dy = jy - y;
+   auto distance2 = dx * dx + dy * dy;
+   if (distance2 > radius2)
+   {
+    return true;
+   }
+
+   if (distance2 < separation2 && distance2 > 0)
+   {
+    // Stronger the closer they are, nothing at the separation distance
+    auto distance = sqrt(distance2);
+    auto push = (rules.separationDistance - distance) / (rules.separationDistance * distance);
+    pushX -= dx * push;
+    pushY -= dy * push;
+   }
+
+   if (batch.species[j] == species)
+   {
+    same++;
+    sumSpeedX += batch.speedX[j];
+    sumSpeedY += batch.speedY[j];
+    sumOffsetX += dx;
+    sumOffsetY += dy;
+   }
+
+   return ++seen < mMaxNeighbors;
+  };
+
+  // Own cell first, then the rest of the cells in reach
+  auto column = mGrid.GetColumn(x);
+  auto row = mGrid.GetRow(y);
+  if (mGrid.ForEachInCell(column, row, visit))
+  {
+   auto column0 = mGrid.GetColumn(x - mRadius);
+   auto column1 = mGrid.GetColumn(x + mRadius);
+   auto row0 = mGrid.GetRow(y - mRadius);
+   auto row1 = mGrid.GetRow(y + mRadius);
+   bool more = true;
+   for (int r = row0; r <= row1 && more; r++)
+   {
+    for (int c = column0; c <= column1 && more; c++)
+    {
+     if (r != row || c != column)
+     {
+      more = mGrid.ForEachInCell(c, r, visit);
+     }
+    }
+   }
+  }
+
+  auto accelX = rules.separation * pushX;
+  auto accelY = rules.separation * pushY;
+  if (same > 0)
+  {
+   accelX += rules.alignment * (sumSpeedX / same - speedX) + rules.cohesion * sumOffsetX / same;
+   accelY += rules.alignment * (sumSpeedY / same - speedY) + rules.cohesion * sumOffsetY / same;
+  }
+
+  speedX += accelX * elapsed;
+  speedY += accelY * elapsed;
+
+  auto speed = sqrt(speedX * speedX + speedY * speedY);
+  if (speed > rules.maxSpeed)
+  {
+   speedX *= rules.maxSpeed / speed;
+   speedY *= rules.maxSpeed / speed;
+  }
+  else if (speed < rules.minSpeed && speed > 0)
+  {
+   speedX *= rules.minSpeed / speed;
+   speedY *= rules.minSpeed / speed;
+  }
+
+  batch.newSpeedX[i] = speedX;
+  batch.newSpeedY[i] = speedY;
+  if (speedX != 0)
+  {
+   batch.mirror[i] = speedX < 0 ? 1 : 0;
+  }
+ }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file Schooling.h
+ * @author Yeji Lee
+ *
+ * Declaration of the Schooling class.
+ *
+ * Boids style schooling: each fish steers away from fish that are
+ * too close, towards the heading of nearby fish of its own kind and
+ * towards the middle of them. Neighbors come from a SpatialGrid, so
+ * the cost grows with the number of fish, not with its square.
+ */
+
+#ifndef AQUARIUM_SCHOOLING_H
+#define AQUARIUM_SCHOOLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SpatialGrid.h"
+
+/// Kinds of fish, a fish only schools with its own kind
+enum class FishSpecies : uint8_t {None, Beta, Nemo, Dory, Count};
+
+/**
+ * How one species schools
+ */
+struct SchoolRules {
+ bool enabled = true;               ///< Does this species school at all
+ double separation = 300;           ///< Push away from a fish right on top, in pixels per second squared
+ double separationDistance = 25;    ///< Fish closer than this push apart, in pixels
+ double alignment = 1.5;            ///< How fast speeds match the neighbors, per second
+ double cohesion = 0.8;             ///< Pull towards the neighbors' middle, per second squared
+ double minSpeed = 20;              ///< Slowest a schooling fish swims, in pixels per second
+ double maxSpeed = 120;             ///< Fastest a schooling fish swims, in pixels per second
+};
+
+/**
+ * Pointers to the fish arrays schooling reads and writes, one entry per fish
+ */
+struct SchoolBatch {
+ const double *x = nullptr;         ///< X location of the fish center
+ const double *y = nullptr;         ///< Y location of the fish center
+ const double *speedX = nullptr;    ///< X speed in pixels per second
+ const double *speedY = nullptr;    ///< Y speed in pixels per second
+ const uint8_t *species = nullptr;  ///< FishSpecies of each fish
+ double *newSpeedX = nullptr;       ///< X speed after steering
+ double *newSpeedY = nullptr;       ///< Y speed after steering
+ uint8_t *mirror = nullptr;         ///< Set to face the way the fish now swims
+};
+
+/**
+ * Schooling settings and the neighbor grid.
+ *
+ * Build files the fish into the grid, then Steer works out new
+ * speeds from the old ones. Steer only reads the old speeds and
+ * writes the new ones to separate arrays, so any number of threads
+ * can steer different fish at once and get the same result.
+ *
+ * A fish looks at no more than a set number of neighbors, starting
+ * with the ones in its own grid cell. In a crowd that keeps the
+ * work per fish fixed, at the cost of ignoring some of the crowd.
+ */
+class Schooling {
+private:
+ /// Is schooling on at all
+ bool mEnabled = false;
+
+ /// Fish further apart than this do not see each other, in pixels
+ double mRadius = 40;
+
+ /// Most neighbors one fish looks at
+ int mMaxNeighbors = 8;
+
+ /// Rules for each species
+ SchoolRules mRules[(int)FishSpecies::Count];
+
+ /// Fish locations bucketed by cells the size of the radius
+ SpatialGrid mGrid;
+
+ /// Width the grid was sized for
+ double mGridWidth = 0;
+
+ /// Height the grid was sized for
+ double mGridHeight = 0;
+
+ /// Cell size the grid was sized for
+ double mGridCellSize = 0;
+
+public:
+ Schooling();
+
+ void Build(const double *x, const double *y, size_t count, double width, double height);
+ void Steer(const SchoolBatch &batch, size_t begin, size_t end, double elapsed) const;
+
+ /**
+  * Is schooling on?
+  * @return True if fish school
+  */
+ bool IsEnabled() const { return mEnabled; }
+
+ /**
+  * Turn schooling on or off
+  * @param enabled True to make fish school
+  */
+ void SetEnabled(bool enabled) { mEnabled = enabled; }
+
+ /**
+  * How far a fish sees its neighbors
+  * @return Radius in pixels
+  */
+ double GetRadius() const { return mRadius; }
+
+ /**
+  * Set how far a fish sees its neighbors
+  * @param radius Radius in pixels
+  */
+ void SetRadius(double radius) { mRadius = radius; }
+
+ /**
+  * Most neighbors one fish looks at
+  * @return Neighbor count
+  */
+ int GetMaxNeighbors() const { return mMaxNeighbors; }
+
+ /**
+  * Set the most neighbors one fish looks at
+  * @param maxNeighbors Neighbor count
+  */
+ void SetMaxNeighbors(int maxNeighbors) { mMaxNeighbors = maxNeighbors; }
+
+ /**
+  * How a species schools
+  * @param species The species
+  * @return Its rules
+  */
+ const SchoolRules &GetRules(FishSpecies species) const { return mRules[(int)species]; }
+
+ /**
+  * Set how a species schools
+  * @param species The species
+  * @param rules Its new rules
+  */
+ void SetRules(FishSpecies species, const SchoolRules &rules) { mRules[(int)species] = rules; }
+
+ /**
+  * The grid of fish locations from the last Build
+  * @return The grid, indices are the order the fish were built in
+  */
+ const SpatialGrid &GetGrid() const { return mGrid; }
+};
+
+#endif //AQUARIUM_SCHOOLING_H
@@ -0,0 +1,289 @@
+/**
+ * @file SessionLog.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SessionWriter and SessionReader classes.
+ */
+
+#include "pch.h"
+#include "SessionLog.h"
+#include <cstring>
+
+using namespace std;
+
+const char SessionWriter::Magic[4] = {'A', 'Q', 'S', 'L'};
+
+/**
+ * Write one byte
+ * @param value The byte
+ */
+void SessionWriter::Byte(uint8_t value)
+{
+ mData.push_back(value);
+}
+
+/**
+ * Write an unsigned integer in as few bytes as it needs,
+ * seven bits to a byte, low bits first
+ * @param value The integer
+ */
+void SessionWriter::Varint(uint64_t value)
+{
+ while (value >= 0x80)
+ {
+  mData.push_back(uint8_t(value) | 0x80);
+  value >>= 7;
+ }
+
+ mData.push_back(uint8_t(value));
+}
+
+/**
+ * Write an unsigned integer as eight bytes, low byte first
+ * @param value The integer
+ */
+void SessionWriter::Fixed(uint64_t value)
+{
+ for (int i = 0; i < 8; i++)
+ {
+  mData.push_back(uint8_t(value >> (i * 8)));
+ }
+}
+
+/**
+ * Write a double bit for bit
+ * @param value The double
+ */
+void SessionWriter::Double(double value)
+{
+ uint64_t bits;
+ memcpy(&bits, &value, sizeof(bits));
+ Fixed(bits);
+}
+
+/**
+ * Write a string as its length and then its characters
+ * @param value The string
+ */
+void SessionWriter::String(const std::wstring &value)
+{
+ Varint(value.size());
+ for (auto c : value)
+ {
+  Varint(uint32_t(c));
+ }
+}
+
+/**
+ * Write a block of bytes as its length and then the bytes
+ * @param value The bytes
+ */
+void SessionWriter::Bytes(const std::string &value)
+{
+ Varint(value.size());
+ mData.insert(mData.end(), value.begin(), value.end());
+}
+
+/**
+ * Write a command as its type and then what that type uses
+ * @param command The command
+ */
+void SessionWriter::Command(const AquariumCommand &command)
+{
+ Byte(uint8_t(SessionRecord::Command));
+ Byte(uint8_t(command.type));
+
+ switch (command.type)
+ {
+ case AquariumCommand::Type::Add:
+  String(command.name);
+  break;
+
+ case AquariumCommand::Type::Move:
+  Varint(command.item.index);
+  Varint(command.item.generation);
+  Double(command.x);
+  Double(command.y);
+  break;
+
+ case AquariumCommand::Type::BringToFront:
+  Varint(command.item.index);
+  Varint(command.item.generation);
+  break;
+
+ case AquariumCommand::Type::Load:
+  String(command.name);
+  Bytes(command.data);
+  break;
+
+ case AquariumCommand::Type::Schooling:
+  Byte(command.enabled ? 1 : 0);
+  break;
+
+ default:
+  break;
+ }
+}
+
+/**
+ * Constructor
+ * @param data The log
+ * @param size Size of the log in bytes
+ */
+SessionReader::SessionReader(const uint8_t *data, size_t size) : mNext(data), mEnd(data + size)
+{
+}
+
+/**
+ * Read one byte
+ * @return The byte
+ */
+uint8_t SessionReader::Byte()
+{
+ if (mNext == mEnd)
+ {
+  mOk = false;
+  return 0;
+ }
+
+ return *mNext++;
+}
+
+/**
+ * Read an integer written by SessionWriter::Varint
+ * @return The integer
+ */
+uint64_t SessionReader::Varint()
+{
+ uint64_t value = 0;
+ for (int shift = 0; shift < 64; shift += 7)
+ {
+  auto byte = Byte();
+  value |= uint64_t(byte & 0x7f) << shift;
+  if ((byte & 0x80) == 0)
+  {
+   return value;
+  }
+ }
+
+ mOk = false;
+ return 0;
+}
+
+/**
+ * Read an integer written by SessionWriter::Fixed
+ * @return The integer
+ */
+uint64_t SessionReader::Fixed()
+{
+ uint64_t value = 0;
+ for (int i = 0; i < 8; i++)
+ {
+  value |= uint64_t(Byte()) << (i * 8);
+ }
+
+ return value;
+}
+
+/**
+ * Read a double written by SessionWriter::Double
+ * @return The double
+ */
+double SessionReader::Double()
+{
+ auto bits = Fixed();
+ double value;
+ memcpy(&value, &bits, sizeof(value));
+ return value;
+}
+
+/**
+ * Read a string written by SessionWriter::String
+ * @return The string
+ */
+std::wstring SessionReader::String()
+{
+ auto size = Varint();
+ if (size > size_t(mEnd - mNext))
+ {
+  // Every character takes at least a byte
+  mOk = false;
+  return wstring();
+ }
+
+ wstring value;
+ value.reserve(size);
+ for (uint64_t i = 0; i < size; i++)
+ {
+  value.push_back(wchar_t(Varint()));
+ }
+
+ return value;
+}
+
+/**
+ * Read bytes written by SessionWriter::Bytes
+ * @return The bytes
+ */
+std::string SessionReader::Bytes()
+{
+ auto size = Varint();
+ if (size > size_t(mEnd - mNext))
+ {
+  mOk = false;
+  return string();
+ }
+
+ string value((const char *)mNext, size);
+ mNext += size;
+ return value;
+}
+
+/**
+ * Read a command written by SessionWriter::Command, after
+ * its SessionRecord::Command byte
+ * @param command Command to fill in
+ * @return false if the command is not one a log can hold
+ */
+bool SessionReader::Command(AquariumCommand &command)
+{
+ command = AquariumCommand();
+ command.type = AquariumCommand::Type(Byte());
+
+ switch (command.type)
+ {
+ case AquariumCommand::Type::Add:
+  command.name = String();
+  break;
+
+ case AquariumCommand::Type::Move:
+  command.item.index = uint32_t(Varint());
+  command.item.generation = uint32_t(Varint());
+  command.x = Double();
+  command.y = Double();
+  break;
+
+ case AquariumCommand::Type::BringToFront:
+  command.item.index = uint32_t(Varint());
+  command.item.generation = uint32_t(Varint());
+  break;
+
+ case AquariumCommand::Type::Load:
+  command.name = String();
+  command.data = Bytes();
+  break;
+
+ case AquariumCommand::Type::Clear:
+  break;
+
+ case AquariumCommand::Type::Schooling:
+  command.enabled = Byte() != 0;
+  break;
+
+ default:
+  mOk = false;
+  break;
+ }
+
+ return mOk;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SessionLog.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SessionWriter and SessionReader classes.
+ *
+ * The compact binary form of a recorded session: the seed it
+ * started from, the time of every frame and every command the
+ * user gave, so it can be run again exactly.
+ */
+
+#ifndef AQUARIUM_SESSIONLOG_H
+#define AQUARIUM_SESSIONLOG_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AquariumCommand.h"
+
+/**
+ * The kinds of record in a session log, after its header.
+ *
+ * The header is the magic bytes, the version, the seed, whether
+ * schooling was on and the generations of the handle table.
+ */
+enum class SessionRecord : uint8_t {
+ Command = 1,     ///< A command, carried out before the next frame
+ Frame = 2,       ///< A frame and its elapsed time
+ Repeat = 3,      ///< A run of frames as long as the last, with no commands
+ Hash = 4,        ///< The frame count and state hash at a checkpoint
+ End = 5,         ///< The frame count and state hash at the end
+ FastForward = 6  ///< A number of steps simulated by Aquarium::FastForward
+};
+
+/**
+ * Builds a session log in memory.
+ *
+ * Counts and sizes are written as variable length integers, so
+ * most records take a few bytes. Times and locations are written
+ * bit for bit, so they are read back exactly.
+ */
+class SessionWriter {
+private:
+ /// The bytes written so far
+ std::vector<uint8_t> mData;
+
+public:
+ /// The first bytes of every session log
+ static const char Magic[4];
+
+ /// Version of the log format
+ static const uint8_t Version = 1;
+
+ void Byte(uint8_t value);
+ void Varint(uint64_t value);
+ void Fixed(uint64_t value);
+ void Double(double value);
+ void String(const std::wstring &value);
+ void Bytes(const std::string &value);
+ void Command(const AquariumCommand &command);
+
+ /**
+  * Get the bytes written so far
+  * @return Reference to the bytes
+  */
+ const std::vector<uint8_t> &GetData() const { return mData; }
+
+ /**
+  * Forget the bytes written so far, once they are on disk
+  */
+ void Clear() { mData.clear(); }
+};
+
+/**
+ * Reads back what a SessionWriter wrote.
+ *
+ * Reading past the end, or anything malformed, reads zeros and
+ * empty strings from then on and IsOk turns false.
+ */
+class SessionReader {
+private:
+ /// Next byte to read
+ const uint8_t *mNext;
+
+ /// One past the last byte
+ const uint8_t *mEnd;
+
+ /// False once a read failed
+ bool mOk = true;
+
+public:
+ SessionReader(const uint8_t *data, size_t size);
+
+ uint8_t Byte();
+ uint64_t Varint();
+ uint64_t Fixed();
+ double Double();
+ std::wstring String();
+ std::string Bytes();
+ bool Command(AquariumCommand &command);
+
+ /**
+  * Has every read so far succeeded?
+  * @return false if the log was cut short or malformed
+  */
+ bool IsOk() const { return mOk; }
+
+ /**
+  * Is everything read?
+  * @return true if there are no bytes left
+  */
+ bool AtEnd() const { return mNext == mEnd; }
+};
+
+#endif //AQUARIUM_SESSIONLOG_H
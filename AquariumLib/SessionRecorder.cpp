@@ -0,0 +1,166 @@
+/**
+ * @file SessionRecorder.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SessionRecorder class.
+ */
+
+#include "pch.h"
+#include "SessionRecorder.h"
+#include "Aquarium.h"
+#include <wx/ffile.h>
+
+using namespace std;
+
+/// Bytes of records to gather before writing them to the file
+const size_t FlushSize = 64 * 1024;
+
+/**
+ * Constructor
+ */
+SessionRecorder::SessionRecorder()
+{
+}
+
+/**
+ * Destructor
+ */
+SessionRecorder::~SessionRecorder()
+{
+}
+
+/**
+ * Create the log file
+ * @param filename File to record to, replaced if it exists
+ * @return false if the file could not be created
+ */
+bool SessionRecorder::Open(const std::wstring &filename)
+{
+ mFile = make_unique<wxFFile>(filename, "wb");
+ return mFile->IsOpened();
+}
+
+/**
+ * Write the header, once the aquarium has been restarted
+ * @param seed Seed the aquarium was restarted with
+ * @param schooling Whether schooling is on
+ * @param generations Generations of the handle table, see Aquarium::GetGenerations
+ */
+void SessionRecorder::Begin(uint64_t seed, bool schooling, const std::vector<uint32_t> &generations)
+{
+ for (auto c : SessionWriter::Magic)
+ {
+  mWriter.Byte(uint8_t(c));
+ }
+
+ mWriter.Byte(SessionWriter::Version);
+ mWriter.Fixed(seed);
+ mWriter.Byte(schooling ? 1 : 0);
+ mWriter.Varint(generations.size());
+ for (auto generation : generations)
+ {
+  mWriter.Varint(generation);
+ }
+}
+
+/**
+ * Record a command the aquarium is about to carry out
+ * @param command The command, with the file contents if it is a Load
+ */
+void SessionRecorder::Command(const AquariumCommand &command)
+{
+ EndRepeats();
+ mWriter.Command(command);
+ mCommanded = true;
+}
+
+/**
+ * Record a frame the aquarium just advanced by
+ * @param elapsed Elapsed time the aquarium was advanced by
+ * @param aquarium The aquarium, hashed at checkpoints
+ */
+void SessionRecorder::Frame(double elapsed, const Aquarium &aquarium)
+{
+ mFrames++;
+ if (!mCommanded && elapsed == mLastElapsed)
+ {
+  mRepeats++;
+ }
+ else
+ {
+  EndRepeats();
+  mWriter.Byte(uint8_t(SessionRecord::Frame));
+  mWriter.Double(elapsed);
+  mLastElapsed = elapsed;
+ }
+
+ mCommanded = false;
+
+ if (mFrames % CheckpointFrames == 0)
+ {
+  EndRepeats();
+  mWriter.Byte(uint8_t(SessionRecord::Hash));
+  mWriter.Varint(mFrames);
+  mWriter.Fixed(aquarium.GetStateHash());
+ }
+
+ if (mWriter.GetData().size() >= FlushSize)
+ {
+  Flush();
+ }
+}
+
+/**
+ * Record a fast forward the aquarium just ran
+ * @param steps Number of steps it simulated
+ */
+void SessionRecorder::FastForward(uint64_t steps)
+{
+ EndRepeats();
+ mWriter.Byte(uint8_t(SessionRecord::FastForward));
+ mWriter.Varint(steps);
+}
+
+/**
+ * Write the final state hash and close the file
+ * @param aquarium The aquarium, hashed one last time
+ * @return false if anything could not be written
+ */
+bool SessionRecorder::Close(const Aquarium &aquarium)
+{
+ EndRepeats();
+ mWriter.Byte(uint8_t(SessionRecord::End));
+ mWriter.Varint(mFrames);
+ mWriter.Fixed(aquarium.GetStateHash());
+ Flush();
+
+ mOk = mFile->Close() && mOk;
+ return mOk;
+}
+
+/**
+ * Write out the run of repeated frames, if there is one
+ */
+void SessionRecorder::EndRepeats()
+{
+ if (mRepeats > 0)
+ {
+  mWriter.Byte(uint8_t(SessionRecord::Repeat));
+  mWriter.Varint(mRepeats);
+  mRepeats = 0;
+ }
+}
+
+/**
+ * Write the gathered records to the file
+ */
+void SessionRecorder::Flush()
+{
+ auto &data = mWriter.GetData();
+ if (mFile->Write(data.data(), data.size()) != data.size())
+ {
+  mOk = false;
+ }
+
+ mWriter.Clear();
+}
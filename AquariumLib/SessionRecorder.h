@@ -0,0 +1,86 @@
+/**
+ * @file SessionRecorder.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SessionRecorder class.
+ *
+ * Writes what happens to an aquarium to a session log as it
+ * happens, so SessionReplayer can run it again.
+ */
+
+#ifndef AQUARIUM_SESSIONRECORDER_H
+#define AQUARIUM_SESSIONRECORDER_H
+
+#include <memory>
+#include <string>
+#include "SessionLog.h"
+
+class Aquarium;
+class wxFFile;
+
+/**
+ * Records a session of an aquarium to a file.
+ *
+ * The aquarium tells the recorder the seed it started from, each
+ * command it carries out and the elapsed time of each frame. A run
+ * of equal frames with no commands between them is written as one
+ * Repeat record, and every CheckpointFrames frames the state hash
+ * is written so a replay can say where it first went different.
+ *
+ * Writes are buffered and go to the file a block at a time, so
+ * recording adds next to nothing to a frame.
+ */
+class SessionRecorder {
+private:
+ /// The log file
+ std::unique_ptr<wxFFile> mFile;
+
+ /// Records not yet written to the file
+ SessionWriter mWriter;
+
+ /// Frames recorded so far
+ uint64_t mFrames = 0;
+
+ /// Elapsed time of the last Frame record
+ double mLastElapsed = 0;
+
+ /// Frames like the last one not yet written
+ uint64_t mRepeats = 0;
+
+ /// Was a command recorded since the last frame?
+ bool mCommanded = true;
+
+ /// False once a write to the file failed
+ bool mOk = true;
+
+ void EndRepeats();
+ void Flush();
+
+public:
+ /// Frames between state hash checkpoints
+ static const uint64_t CheckpointFrames = 600;
+
+ SessionRecorder();
+ ~SessionRecorder();
+
+ /// Copy constructor (disabled)
+ SessionRecorder(const SessionRecorder &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const SessionRecorder &) = delete;
+
+ bool Open(const std::wstring &filename);
+ void Begin(uint64_t seed, bool schooling, const std::vector<uint32_t> &generations);
+ void Command(const AquariumCommand &command);
+ void Frame(double elapsed, const Aquarium &aquarium);
+ void FastForward(uint64_t steps);
+ bool Close(const Aquarium &aquarium);
+
+ /**
+  * Number of frames recorded so far
+  * @return Frame count
+  */
+ uint64_t GetFrames() const { return mFrames; }
+};
+
+#endif //AQUARIUM_SESSIONRECORDER_H
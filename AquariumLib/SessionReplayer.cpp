@@ -0,0 +1,177 @@
+/**
+ * @file SessionReplayer.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SessionReplayer class.
+ */
+
+#include "pch.h"
+#include "SessionReplayer.h"
+#include "SessionLog.h"
+#include "Aquarium.h"
+#include <wx/ffile.h>
+#include <chrono>
+
+using namespace std;
+
+/**
+ * Read a session log from a file
+ * @param filename The file
+ * @return false if it could not be read
+ */
+bool SessionReplayer::Open(const std::wstring &filename)
+{
+ wxFFile file(filename, "rb");
+ if (!file.IsOpened())
+ {
+  mError = L"Unable to open " + filename;
+  return false;
+ }
+
+ mData.resize(size_t(file.Length()));
+ if (file.Read(mData.data(), mData.size()) != mData.size())
+ {
+  mError = L"Unable to read " + filename;
+  return false;
+ }
+
+ return true;
+}
+
+/**
+ * Replay the log into an aquarium
+ * @param aquarium The aquarium, emptied and restarted first
+ * @return true if the whole log was replayed and every state hash matched
+ */
+bool SessionReplayer::Run(Aquarium &aquarium)
+{
+ auto start = chrono::steady_clock::now();
+ mError.clear();
+ mFrames = mCommands = mCheckpoints = 0;
+
+ SessionReader reader(mData.data(), mData.size());
+ for (auto c : SessionWriter::Magic)
+ {
+  if (reader.Byte() != uint8_t(c))
+  {
+   mError = L"Not a session log";
+   return false;
+  }
+ }
+
+ if (reader.Byte() != SessionWriter::Version)
+ {
+  mError = L"Unsupported session log version";
+  return false;
+ }
+
+ auto seed = reader.Fixed();
+ bool schooling = reader.Byte() != 0;
+ vector<uint32_t> generations(size_t(min<uint64_t>(reader.Varint(), mData.size())));
+ for (auto &generation : generations)
+ {
+  generation = uint32_t(reader.Varint());
+ }
+
+ aquarium.Restart(seed);
+ aquarium.SetGenerations(generations);
+ aquarium.GetFishStore().GetSchooling().SetEnabled(schooling);
+
+ double elapsed = 0;
+ bool ended = false;
+ while (reader.IsOk() && !ended && mError.empty())
+ {
+  auto record = SessionRecord(reader.Byte());
+  switch (record)
+  {
+  case SessionRecord::Command:
+  {
+   AquariumCommand command;
+   if (reader.Command(command))
+   {
+    // The queue may fill up, in which case carry out what is on it first
+    if (!aquarium.Send(std::move(command)))
+    {
+     aquarium.ExecuteCommands();
+     aquarium.Send(std::move(command));
+    }
+
+    mCommands++;
+   }
+   break;
+  }
+
+  case SessionRecord::Frame:
+   elapsed = reader.Double();
+   aquarium.ExecuteCommands();
+   aquarium.Advance(elapsed);
+   mFrames++;
+   break;
+
+  case SessionRecord::Repeat:
+  {
+   auto repeats = reader.Varint();
+   for (uint64_t i = 0; i < repeats; i++)
+   {
+    aquarium.ExecuteCommands();
+    aquarium.Advance(elapsed);
+   }
+
+   mFrames += repeats;
+   break;
+  }
+
+  case SessionRecord::FastForward:
+  {
+   auto steps = reader.Varint();
+   aquarium.ExecuteCommands();
+   aquarium.FastForward(double(steps) * aquarium.GetClock().GetStep());
+   break;
+  }
+
+  case SessionRecord::Hash:
+  case SessionRecord::End:
+  {
+   auto frames = reader.Varint();
+   auto hash = reader.Fixed();
+   if (!reader.IsOk())
+   {
+    break;
+   }
+
+   ended = record == SessionRecord::End;
+
+   // Commands sent in the same batch as the one that stopped the
+   // recording were carried out before it hashed, so do the same
+   aquarium.ExecuteCommands();
+
+   if (frames != mFrames)
+   {
+    mError = L"Frame count differs at frame " + to_wstring(mFrames);
+   }
+   else if (hash != aquarium.GetStateHash())
+   {
+    mError = L"State differs at frame " + to_wstring(mFrames);
+   }
+   else
+   {
+    mCheckpoints++;
+   }
+   break;
+  }
+
+  default:
+   mError = L"Malformed session log";
+   break;
+  }
+ }
+
+ if (mError.empty() && !ended)
+ {
+  mError = L"Session log is cut short at frame " + to_wstring(mFrames);
+ }
+
+ mSimulated = double(aquarium.GetClock().GetTicks()) * aquarium.GetClock().GetStep();
+ mWall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+ return mError.empty();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file SessionReplayer.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SessionReplayer class.
+ *
+ * Runs a session recorded by SessionRecorder again, as fast as
+ * it will go, and checks it ends up where the recording did.
+ */
+
+#ifndef AQUARIUM_SESSIONREPLAYER_H
+#define AQUARIUM_SESSIONREPLAYER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Aquarium;
+
+/**
+ * Replays a session log into an aquarium.
+ *
+ * The aquarium is restarted from the recorded seed and handle
+ * table, then given each recorded command and frame in turn with
+ * nothing drawn and no waiting. At every checkpoint and at the end
+ * its state hash is compared with the recorded one, and the replay
+ * stops at the first that differs.
+ */
+class SessionReplayer {
+private:
+ /// The log
+ std::vector<uint8_t> mData;
+
+ /// Why the replay failed, empty if it did not
+ std::wstring mError;
+
+ /// Frames replayed
+ uint64_t mFrames = 0;
+
+ /// Commands replayed
+ uint64_t mCommands = 0;
+
+ /// State hashes that matched
+ uint64_t mCheckpoints = 0;
+
+ /// Simulated time replayed in seconds
+ double mSimulated = 0;
+
+ /// Time the replay took in seconds
+ double mWall = 0;
+
+public:
+ bool Open(const std::wstring &filename);
+ bool Run(Aquarium &aquarium);
+
+ /**
+  * Set the log to replay, instead of opening a file
+  * @param data The log
+  */
+ void SetData(std::vector<uint8_t> data) { mData = std::move(data); }
+
+ /**
+  * Get the log being replayed
+  * @return Reference to the log
+  */
+ const std::vector<uint8_t> &GetData() const { return mData; }
+
+ /**
+  * Why Open or Run failed
+  * @return The reason, empty if neither did
+  */
+ const std::wstring &GetError() const { return mError; }
+
+ /**
+  * Number of frames replayed
+  * @return Frame count
+  */
+ uint64_t GetFrames() const { return mFrames; }
+
+ /**
+  * Number of commands replayed
+  * @return Command count
+  */
+ uint64_t GetCommands() const { return mCommands; }
+
+ /**
+  * Number of state hashes that matched, the final one included
+  * @return Checkpoint count
+  */
+ uint64_t GetCheckpoints() const { return mCheckpoints; }
+
+ /**
+  * Simulated time replayed
+  * @return Seconds of simulation
+  */
+ double GetSimulatedSeconds() const { return mSimulated; }
+
+ /**
+  * Time the replay took
+  * @return Wall clock seconds
+  */
+ double GetWallSeconds() const { return mWall; }
+};
+
+#endif //AQUARIUM_SESSIONREPLAYER_H
@@ -0,0 +1,57 @@
+/**
+ * @file SimulationClock.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SimulationClock class.
+ */
+
+#include "pch.h"
+#include "SimulationClock.h"
+#include <cmath>
+
+/**
+ * Constructor
+ * @param step Length of one simulation step in seconds
+ * @param maxSteps Most steps to run for one frame
+ */
+SimulationClock::SimulationClock(double step, int maxSteps) : mStep(step), mMaxSteps(maxSteps)
+{
+}
+
+/**
+ * Add the time since the last frame
+ * @param elapsed Time since the last frame in seconds
+ * @return Number of steps to simulate for this frame
+ */
+int SimulationClock::Advance(double elapsed)
+{
+ if (elapsed > 0)
+ {
+  mAccumulator += elapsed;
+ }
+
+ int steps = 0;
+ while (mAccumulator >= mStep && steps < mMaxSteps)
+ {
+  mAccumulator -= mStep;
+  steps++;
+ }
+
+ if (mAccumulator >= mStep)
+ {
+  // Too far behind to catch up, drop the whole steps we missed
+  mAccumulator = std::fmod(mAccumulator, mStep);
+ }
+
+ mTicks += steps;
+ return steps;
+}
+
+/**
+ * Forget any time not yet simulated and restart the tick count
+ */
+void SimulationClock::Reset()
+{
+ mAccumulator = 0;
+ mTicks = 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file SimulationClock.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SimulationClock class.
+ *
+ * Turns the uneven time between frames into a whole number of
+ * equal simulation steps, so the simulation does not depend on
+ * how often or how late the window repaints.
+ */
+
+#ifndef AQUARIUM_SIMULATIONCLOCK_H
+#define AQUARIUM_SIMULATIONCLOCK_H
+
+#include <cstdint>
+
+/**
+ * Fixed timestep clock with an accumulator.
+ *
+ * Frame time goes into the accumulator and comes out as fixed
+ * steps. What is left over, less than one step, tells the renderer
+ * how far to interpolate between the last two simulated states.
+ * After a long stall only a limited number of steps are run and
+ * the rest of the backlog is dropped, so a hiccup slows the fish
+ * for a moment instead of making them jump.
+ */
+class SimulationClock {
+private:
+ /// Length of one simulation step in seconds
+ double mStep;
+
+ /// Most steps one frame may run
+ int mMaxSteps;
+
+ /// Time not yet simulated in seconds
+ double mAccumulator = 0;
+
+ /// Total steps run
+ uint64_t mTicks = 0;
+
+public:
+ SimulationClock(double step, int maxSteps);
+
+ int Advance(double elapsed);
+ void Reset();
+
+ /**
+  * Count steps simulated without going through Advance, such as
+  * by a fast forward. The time left over is not touched.
+  * @param steps Number of steps
+  */
+ void Skip(uint64_t steps) { mTicks += steps; }
+
+ /**
+  * Length of one step
+  * @return Step in seconds
+  */
+ double GetStep() const { return mStep; }
+
+ /**
+  * How far between the last two steps the frame falls
+  * @return Fraction from 0 (previous step) to 1 (last step)
+  */
+ double GetAlpha() const { return mAccumulator / mStep; }
+
+ /**
+  * Total number of steps run since the clock started or was reset
+  * @return Step count
+  */
+ uint64_t GetTicks() const { return mTicks; }
+};
+
+#endif //AQUARIUM_SIMULATIONCLOCK_H
@@ -0,0 +1,98 @@
+/**
+ * @file SimulationThread.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SimulationThread class.
+ */
+
+#include "pch.h"
+#include "SimulationThread.h"
+#include "Aquarium.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+/**
+ * Constructor
+ * @param aquarium The aquarium to simulate, must outlive the thread
+ */
+SimulationThread::SimulationThread(Aquarium *aquarium) : mAquarium(aquarium)
+{
+}
+
+/**
+ * Destructor, stops the thread
+ */
+SimulationThread::~SimulationThread()
+{
+ Stop();
+}
+
+/**
+ * Start simulating
+ */
+void SimulationThread::Start()
+{
+ if (mThread.joinable())
+ {
+  return;
+ }
+
+ mStop = false;
+ mThread = thread(&SimulationThread::Run, this);
+}
+
+/**
+ * Stop simulating and wait for the thread to finish
+ */
+void SimulationThread::Stop()
+{
+ {
+  lock_guard<mutex> lock(mMutex);
+  mStop = true;
+ }
+ mWake.notify_all();
+
+ if (mThread.joinable())
+ {
+  mThread.join();
+ }
+}
+
+/**
+ * Body of the simulation thread
+ */
+void SimulationThread::Run()
+{
+ auto step = duration_cast<steady_clock::duration>(duration<double>(mAquarium->GetClock().GetStep()));
+ auto last = steady_clock::now();
+ auto next = last;
+
+ for (;;)
+ {
+  auto now = steady_clock::now();
+  double elapsed = duration<double>(now - last).count();
+  last = now;
+
+  {
+   auto lock = mAquarium->Lock();
+   mAquarium->ExecuteCommands();
+   mAquarium->Advance(elapsed);
+   mAquarium->Publish();
+  }
+
+  // Sleep until the next step is due, skipping any we are late for
+  next += step;
+  if (next < now)
+  {
+   next = now + step;
+  }
+
+  unique_lock<mutex> lock(mMutex);
+  if (mWake.wait_until(lock, next, [this]() { return mStop; }))
+  {
+   return;
+  }
+ }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file SimulationThread.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SimulationThread class.
+ *
+ * Runs the aquarium simulation on its own thread at the simulation
+ * step rate, publishing a snapshot after every step for the window
+ * to paint whenever it likes.
+ */
+
+#ifndef AQUARIUM_SIMULATIONTHREAD_H
+#define AQUARIUM_SIMULATIONTHREAD_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class Aquarium;
+
+/**
+ * Dedicated simulation thread for an aquarium.
+ *
+ * Each time around, the thread carries out the commands the user
+ * interface has sent, steps the simulation and publishes a snapshot,
+ * then sleeps until the next step is due. It holds the aquarium lock
+ * while it does, which only the rare direct reader like File>Save
+ * ever contends for.
+ */
+class SimulationThread {
+private:
+ /// The aquarium we simulate
+ Aquarium *mAquarium;
+
+ /// The thread, if running
+ std::thread mThread;
+
+ /// Protects mStop
+ std::mutex mMutex;
+
+ /// Wakes the thread early to stop
+ std::condition_variable mWake;
+
+ /// True when the thread should exit
+ bool mStop = false;
+
+ void Run();
+
+public:
+ explicit SimulationThread(Aquarium *aquarium);
+ ~SimulationThread();
+
+ /// Copy constructor (disabled)
+ SimulationThread(const SimulationThread &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const SimulationThread &) = delete;
+
+ void Start();
+ void Stop();
+};
+
+#endif //AQUARIUM_SIMULATIONTHREAD_H
@@ -0,0 +1,198 @@
+/**
+ * @file Snapshot.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the Snapshot class.
+ */
+
+#include "pch.h"
+#include "Snapshot.h"
+#include "Sprite.h"
+#include "SpriteCache.h"
+#include "SpriteAtlas.h"
+#include "Item.h"
+#include "StaticLayer.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Empty the snapshot so it can be filled again.
+ *
+ * The arrays keep their memory, so refilling a snapshot
+ * of the same size allocates nothing.
+ */
+void Snapshot::Clear()
+{
+ mEntries.clear();
+ mSprites.clear();
+ mBackground = nullptr;
+ mStaticCount = 0;
+}
+
+/**
+ * Set the background to draw behind the items
+ * @param background Background sprite
+ */
+void Snapshot::SetBackground(const std::shared_ptr<const Sprite> &background)
+{
+ mBackground = background;
+}
+
+/**
+ * Record when in the simulation this snapshot was taken
+ * @param tick Simulation steps run so far
+ * @param step Length of one step in seconds
+ * @param alpha Fraction of a step not yet simulated
+ */
+void Snapshot::SetTiming(uint64_t tick, double step, double alpha)
+{
+ mTick = tick;
+ mStep = step;
+ mAlpha = alpha;
+ mTime = Clock::now();
+}
+
+/**
+ * Say which of the entries are static
+ * @param count Number of entries at the back that never move
+ * @param version Value that changes whenever those entries do
+ */
+void Snapshot::SetStatic(size_t count, uint64_t version)
+{
+ mStaticCount = count;
+ mStaticVersion = version;
+}
+
+/**
+ * Add an item on top of those already added
+ * @param item Handle of the item, for naming it later
+ * @param sprite Sprite the item draws
+ * @param prevX X location before the last step
+ * @param prevY Y location before the last step
+ * @param x X location
+ * @param y Y location
+ * @param mirror True to draw mirrored
+ */
+void Snapshot::Add(ItemHandle item, const std::shared_ptr<const Sprite> &sprite,
+        double prevX, double prevY, double x, double y, bool mirror)
+{
+ auto id = sprite->GetId();
+ if (id >= (int)mSprites.size())
+ {
+  mSprites.resize(id + 1);
+ }
+
+ if (mSprites[id] == nullptr)
+ {
+  mSprites[id] = sprite;
+ }
+
+ mEntries.push_back({prevX, prevY, x, y, id, mirror, item});
+}
+
+/**
+ * Find the item drawn on top at a location, as of the last step
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ * @return Handle of the item or a null handle if none
+ */
+ItemHandle Snapshot::HitTest(int x, int y) const
+{
+ for (auto entry = mEntries.rbegin(); entry != mEntries.rend(); entry++)
+ {
+  auto &sprite = *mSprites[entry->sprite];
+
+  // Relative to the top left corner of the image
+  double testX = x - entry->x + sprite.GetWidth() / 2.0;
+  double testY = y - entry->y + sprite.GetHeight() / 2.0;
+  if (testX < 0 || testY < 0 || testX >= sprite.GetWidth() || testY >= sprite.GetHeight())
+  {
+   continue;
+  }
+
+  if (sprite.GetHitMask(entry->mirror).Test((int)testX, (int)testY))
+  {
+   return entry->item;
+  }
+ }
+
+ return ItemHandle();
+}
+
+/**
+ * How far between the last two steps to draw at a given time.
+ *
+ * This carries on from the fraction of a step left over when
+ * the snapshot was taken, stopping at the last step.
+ *
+ * @param now Time the frame is drawn
+ * @return Fraction from 0 (previous step) to 1 (last step)
+ */
+double Snapshot::GetAlpha(Clock::time_point now) const
+{
+ if (mStep <= 0)
+ {
+  return 1;
+ }
+
+ double since = chrono::duration<double>(now - mTime).count();
+ return min(1.0, max(0.0, mAlpha + since / mStep));
+}
+
+/**
+ * Draw the snapshot. Must be called on the GUI thread.
+ *
+ * Given a layer, the background, title and static entries come
+ * from it instead of being drawn one by one.
+ *
+ * @param dc Device context to draw on
+ * @param alpha How far between the last two steps to draw the items
+ * @param layer Cached layer of the static entries, or null
+ */
+void Snapshot::Draw(wxDC *dc, double alpha, StaticLayer *layer) const
+{
+ size_t first = 0;
+ if (layer != nullptr && mBackground != nullptr)
+ {
+  layer->Draw(dc, *this);
+  first = mStaticCount;
+ }
+ else
+ {
+  if (mBackground != nullptr)
+  {
+   dc->DrawBitmap(mBackground->GetBitmap(), 0, 0);
+  }
+
+  DrawTitle(dc);
+ }
+
+ // one atlas lookup per frame, items draw from it
+ auto atlas = SpriteCache::Instance().GetAtlas();
+
+ for (size_t i = first; i < mEntries.size(); i++)
+ {
+  auto &entry = mEntries[i];
+  double x = entry.prevX + (entry.x - entry.prevX) * alpha;
+  double y = entry.prevY + (entry.y - entry.prevY) * alpha;
+  Item::DrawSprite(dc, *mSprites[entry.sprite], entry.mirror, x, y, atlas.get());
+ }
+}
+
+/**
+ * Draw the aquarium title
+ * @param dc Device context to draw on
+ */
+void Snapshot::DrawTitle(wxDC *dc)
+{
+ // font for title "Under the Sea!"
+ wxFont font(wxSize(0, 20),
+         wxFONTFAMILY_SWISS,
+         wxFONTSTYLE_NORMAL,
+         wxFONTWEIGHT_NORMAL);
+ dc->SetFont(font);
+ // color = MSU green
+ dc->SetTextForeground(wxColour(0, 64, 0));
+ dc->DrawText(L"Under the Sea!", 10, 10);
+}
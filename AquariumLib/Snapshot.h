@@ -0,0 +1,132 @@
+/**
+ * @file Snapshot.h
+ * @author Yeji Lee
+ *
+ * Declaration of the Snapshot class.
+ *
+ * Everything needed to draw one simulated moment of an aquarium,
+ * copied out of the items so the simulation can keep running
+ * while the window paints.
+ */
+
+#ifndef AQUARIUM_SNAPSHOT_H
+#define AQUARIUM_SNAPSHOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ItemHandle.h"
+
+class Sprite;
+class StaticLayer;
+
+/**
+ * The drawable state of an aquarium after one simulation step.
+ *
+ * A snapshot is filled in by the simulation and then never changed
+ * until the painter is finished with it. It holds the sprites it
+ * uses, indexed by sprite id, and one entry per item in drawing order.
+ * Items are named by handle, which the GUI thread passes back in
+ * an AquariumCommand to say which item it means.
+ *
+ * The first few entries may be static items behind everything that
+ * moves. They are counted, with a version that changes whenever
+ * they do, so a StaticLayer can draw them once and reuse the result.
+ */
+class Snapshot {
+public:
+ /// The clock snapshots are timed with
+ typedef std::chrono::steady_clock Clock;
+
+ /// One item to draw
+ struct Entry {
+  double prevX;   ///< X location of the center before the last step
+  double prevY;   ///< Y location of the center before the last step
+  double x;       ///< X location of the center
+  double y;       ///< Y location of the center
+  int sprite;     ///< Id of the sprite to draw
+  bool mirror;    ///< True to draw mirrored
+  ItemHandle item;    ///< Handle of the item, for naming it in commands
+ };
+
+private:
+ /// The items, back to front
+ std::vector<Entry> mEntries;
+
+ /// Sprites used by the entries, indexed by sprite id
+ std::vector<std::shared_ptr<const Sprite>> mSprites;
+
+ /// The aquarium background
+ std::shared_ptr<const Sprite> mBackground;
+
+ /// Simulation steps run when this was taken
+ uint64_t mTick = 0;
+
+ /// Length of one simulation step in seconds
+ double mStep = 0;
+
+ /// Fraction of a step not yet simulated when this was taken
+ double mAlpha = 1;
+
+ /// When this was taken
+ Clock::time_point mTime;
+
+ /// Number of entries at the back that are static
+ size_t mStaticCount = 0;
+
+ /// Changes whenever the static entries do
+ uint64_t mStaticVersion = 0;
+
+public:
+ void Clear();
+ void SetBackground(const std::shared_ptr<const Sprite> &background);
+ void SetTiming(uint64_t tick, double step, double alpha);
+ void SetStatic(size_t count, uint64_t version);
+ void Add(ItemHandle item, const std::shared_ptr<const Sprite> &sprite,
+         double prevX, double prevY, double x, double y, bool mirror);
+ ItemHandle HitTest(int x, int y) const;
+
+ double GetAlpha(Clock::time_point now) const;
+ void Draw(wxDC *dc, double alpha, StaticLayer *layer = nullptr) const;
+ static void DrawTitle(wxDC *dc);
+
+ /**
+  * The items in drawing order
+  * @return Reference to the entries
+  */
+ const std::vector<Entry> &GetEntries() const { return mEntries; }
+
+ /**
+  * Get a sprite the entries use
+  * @param id Sprite id from an entry
+  * @return The sprite
+  */
+ const Sprite &GetSprite(int id) const { return *mSprites[id]; }
+
+ /**
+  * Get the aquarium background
+  * @return Background sprite, may be null
+  */
+ const std::shared_ptr<const Sprite> &GetBackground() const { return mBackground; }
+
+ /**
+  * Number of entries at the back that are static
+  * @return Static entry count
+  */
+ size_t GetStaticCount() const { return mStaticCount; }
+
+ /**
+  * Version of the static entries
+  * @return Value that changes whenever the static entries do
+  */
+ uint64_t GetStaticVersion() const { return mStaticVersion; }
+
+ /**
+  * Number of simulation steps run when this was taken
+  * @return Tick count
+  */
+ uint64_t GetTick() const { return mTick; }
+};
+
+#endif //AQUARIUM_SNAPSHOT_H
@@ -0,0 +1,42 @@
+/**
+ * @file SnapshotBuffer.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SnapshotBuffer class.
+ */
+
+#include "pch.h"
+#include "SnapshotBuffer.h"
+
+using namespace std;
+
+/**
+ * Hand the back snapshot to the reader. Writer thread only.
+ *
+ * The back snapshot swaps places with the middle one, which
+ * becomes the new back snapshot to fill.
+ */
+void SnapshotBuffer::Publish()
+{
+ auto old = mMiddle.exchange(uint8_t(mBack | Fresh), memory_order_acq_rel);
+ mBack = old & ~Fresh;
+}
+
+/**
+ * Get the newest published snapshot. Reader thread only.
+ *
+ * The snapshot stays valid and unchanged until the next call.
+ *
+ * @return The snapshot or nullptr if nothing has been published yet
+ */
+const Snapshot *SnapshotBuffer::Acquire()
+{
+ if (mMiddle.load(memory_order_relaxed) & Fresh)
+ {
+  auto old = mMiddle.exchange(uint8_t(mFront), memory_order_acq_rel);
+  mFront = old & ~Fresh;
+  mHasFront = true;
+ }
+
+ return mHasFront ? &mSnapshots[mFront] : nullptr;
+}
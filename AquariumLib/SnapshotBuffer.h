@@ -0,0 +1,59 @@
+/**
+ * @file SnapshotBuffer.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SnapshotBuffer class.
+ *
+ * Lock-free triple buffer that hands snapshots from the
+ * simulation thread to the painting thread.
+ */
+
+#ifndef AQUARIUM_SNAPSHOTBUFFER_H
+#define AQUARIUM_SNAPSHOTBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include "Snapshot.h"
+
+/**
+ * Triple buffer of snapshots for one writer and one reader.
+ *
+ * The writer fills the back snapshot and publishes it, the reader
+ * picks up the newest published snapshot as its front one. A third
+ * snapshot sits between them, so neither side ever waits for the
+ * other and the reader never sees a snapshot being written. If the
+ * writer publishes twice before the reader looks, the older one is
+ * simply skipped.
+ */
+class SnapshotBuffer {
+private:
+ /// Bit in mMiddle set when it holds a snapshot the reader has not seen
+ static const uint8_t Fresh = 4;
+
+ /// The three snapshots
+ Snapshot mSnapshots[3];
+
+ /// Index of the snapshot the writer is filling
+ int mBack = 0;
+
+ /// Index of the snapshot between writer and reader, plus the Fresh bit
+ std::atomic<uint8_t> mMiddle{1};
+
+ /// Index of the snapshot the reader is using
+ int mFront = 2;
+
+ /// True once the reader has picked up a snapshot
+ bool mHasFront = false;
+
+public:
+ /**
+  * The snapshot to fill in, writer thread only
+  * @return Reference to the back snapshot
+  */
+ Snapshot &GetBack() { return mSnapshots[mBack]; }
+
+ void Publish();
+ const Snapshot *Acquire();
+};
+
+#endif //AQUARIUM_SNAPSHOTBUFFER_H
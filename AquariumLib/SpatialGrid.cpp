@@ -0,0 +1,121 @@
+/**
+ * @file SpatialGrid.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SpatialGrid class.
+ */
+
+#include "pch.h"
+#include "SpatialGrid.h"
+
+using namespace std;
+
+/**
+ * Constructor, an empty grid of one cell
+ */
+SpatialGrid::SpatialGrid() : mCellStart(2, 0)
+{
+}
+
+/**
+ * Set the area the grid covers and the size of its cells.
+ *
+ * The points are dropped, call Build again afterwards.
+ *
+ * @param width Width of the area in pixels
+ * @param height Height of the area in pixels
+ * @param cellSize Width and height of a cell in pixels
+ */
+void SpatialGrid::Resize(double width, double height, double cellSize)
+{
+ mCellSize = cellSize;
+ mInverseCellSize = 1.0 / cellSize;
+ mColumns = max(1, (int)ceil(width / cellSize));
+ mRows = max(1, (int)ceil(height / cellSize));
+
+ mCellStart.assign((size_t)mColumns * mRows + 1, 0);
+ mIndices.clear();
+ mX.clear();
+ mY.clear();
+}
+
+/**
+ * File every point under its cell, replacing what was there.
+ *
+ * This is a counting sort: count the points in each cell, turn
+ * the counts into start offsets, then drop each point into the
+ * next free place in its cell. Two passes over the points and
+ * one over the cells, with no allocation once the arrays have
+ * grown to size.
+ *
+ * @param x X location of each point
+ * @param y Y location of each point
+ * @param count Number of points
+ */
+void SpatialGrid::Build(const double *x, const double *y, size_t count)
+{
+ fill(mCellStart.begin(), mCellStart.end(), 0);
+ mPointCells.resize(count);
+ mIndices.resize(count);
+ mX.resize(count);
+ mY.resize(count);
+
+ // Count into the slot after each cell so the prefix sum gives the starts
+ for (size_t i = 0; i < count; i++)
+ {
+  auto cell = (uint32_t)(GetRow(y[i]) * mColumns + GetColumn(x[i]));
+  mPointCells[i] = cell;
+  mCellStart[cell + 1]++;
+ }
+
+ for (size_t cell = 1; cell < mCellStart.size(); cell++)
+ {
+  mCellStart[cell] += mCellStart[cell - 1];
+ }
+
+ // Scatter, using each cell's start as its cursor and then putting it back
+ for (size_t i = 0; i < count; i++)
+ {
+  auto to = mCellStart[mPointCells[i]]++;
+  mIndices[to] = (uint32_t)i;
+  mX[to] = x[i];
+  mY[to] = y[i];
+ }
+
+ for (size_t cell = mCellStart.size() - 1; cell > 0; cell--)
+ {
+  mCellStart[cell] = mCellStart[cell - 1];
+ }
+ mCellStart[0] = 0;
+}
+
+/**
+ * Find every point inside a rectangle, edges included
+ * @param left Left edge in pixels
+ * @param top Top edge in pixels
+ * @param right Right edge in pixels
+ * @param bottom Bottom edge in pixels
+ * @param result Cleared and filled with the point indices
+ */
+void SpatialGrid::QueryRect(double left, double top, double right, double bottom, std::vector<int> &result) const
+{
+ result.clear();
+ ForEachInRect(left, top, right, bottom, [&result](int index, double, double) {
+  result.push_back(index);
+ });
+}
+
+/**
+ * Find every point within a distance of a location
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ * @param radius Distance in pixels
+ * @param result Cleared and filled with the point indices
+ */
+void SpatialGrid::QueryRadius(double x, double y, double radius, std::vector<int> &result) const
+{
+ result.clear();
+ ForEachInRadius(x, y, radius, [&result](int index, double, double) {
+  result.push_back(index);
+ });
+}
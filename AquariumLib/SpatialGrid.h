@@ -0,0 +1,198 @@
+/**
+ * @file SpatialGrid.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SpatialGrid class.
+ *
+ * A uniform grid of square cells over the tank that buckets points
+ * by cell, so finding what is near a location only looks at the
+ * few cells around it instead of at everything.
+ */
+
+#ifndef AQUARIUM_SPATIALGRID_H
+#define AQUARIUM_SPATIALGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Uniform grid of points, rebuilt from scratch with a counting sort.
+ *
+ * Build takes the points as parallel x and y arrays and files the
+ * index of each point under its cell. The cells are laid out one
+ * after another in a single array, so a query walks a few short
+ * runs of contiguous memory. The positions are copied in the same
+ * order so a query does not have to go back to the source arrays.
+ *
+ * Points outside the grid are filed under the nearest edge cell,
+ * and queries clamp the same way, so nothing is ever lost.
+ */
+class SpatialGrid {
+private:
+ /// Width and height of a cell in pixels
+ double mCellSize = 64;
+
+ /// One over the cell size
+ double mInverseCellSize = 1.0 / 64;
+
+ /// Number of cells across
+ int mColumns = 1;
+
+ /// Number of cells down
+ int mRows = 1;
+
+ /// Where each cell starts in the arrays below, one extra at the end
+ std::vector<uint32_t> mCellStart;
+
+ /// Point indices, sorted by cell
+ std::vector<uint32_t> mIndices;
+
+ /// X location of each point, sorted by cell
+ std::vector<double> mX;
+
+ /// Y location of each point, sorted by cell
+ std::vector<double> mY;
+
+ /// Cell of each point, in the order they were given
+ std::vector<uint32_t> mPointCells;
+
+public:
+ SpatialGrid();
+
+ /**
+  * Column a location falls in, clamped to the grid
+  * @param x X location in pixels
+  * @return Column index
+  */
+ int GetColumn(double x) const
+ {
+  return std::clamp((int)std::floor(x * mInverseCellSize), 0, mColumns - 1);
+ }
+
+ /**
+  * Row a location falls in, clamped to the grid
+  * @param y Y location in pixels
+  * @return Row index
+  */
+ int GetRow(double y) const
+ {
+  return std::clamp((int)std::floor(y * mInverseCellSize), 0, mRows - 1);
+ }
+
+ void Resize(double width, double height, double cellSize);
+ void Build(const double *x, const double *y, size_t count);
+
+ void QueryRect(double left, double top, double right, double bottom, std::vector<int> &result) const;
+ void QueryRadius(double x, double y, double radius, std::vector<int> &result) const;
+
+ /**
+  * Visit every point inside a rectangle, edges included.
+  *
+  * Points come cell by cell, and in the order they were given
+  * within a cell.
+  *
+  * @param left Left edge in pixels
+  * @param top Top edge in pixels
+  * @param right Right edge in pixels
+  * @param bottom Bottom edge in pixels
+  * @param visit Called with the index, x and y of each point
+  */
+ template <class Visitor>
+ void ForEachInRect(double left, double top, double right, double bottom, Visitor &&visit) const
+ {
+  int column0 = GetColumn(left);
+  int column1 = GetColumn(right);
+  int row0 = GetRow(top);
+  int row1 = GetRow(bottom);
+
+  for (int row = row0; row <= row1; row++)
+  {
+   // The cells of one row are next to each other, so do them as one run
+   auto begin = mCellStart[row * mColumns + column0];
+   auto end = mCellStart[row * mColumns + column1 + 1];
+   for (auto i = begin; i < end; i++)
+   {
+    auto x = mX[i];
+    auto y = mY[i];
+    if (x >= left && x <= right && y >= top && y <= bottom)
+    {
+     visit((int)mIndices[i], x, y);
+    }
+   }
+  }
+ }
+
+ /**
+  * Visit the points in one cell, in the order they were given.
+  *
+  * The visitor returns false to stop early.
+  *
+  * @param column Column of the cell
+  * @param row Row of the cell
+  * @param visit Called with the index, x and y of each point
+  * @return false if the visitor stopped early
+  */
+ template <class Visitor>
+ bool ForEachInCell(int column, int row, Visitor &&visit) const
+ {
+  auto cell = row * mColumns + column;
+  for (auto i = mCellStart[cell]; i < mCellStart[cell + 1]; i++)
+  {
+   if (!visit((int)mIndices[i], mX[i], mY[i]))
+   {
+    return false;
+   }
+  }
+
+  return true;
+ }
+
+ /**
+  * Visit every point within a distance of a location
+  * @param x X location in pixels
+  * @param y Y location in pixels
+  * @param radius Distance in pixels, points right on it count
+  * @param visit Called with the index, x and y of each point
+  */
+ template <class Visitor>
+ void ForEachInRadius(double x, double y, double radius, Visitor &&visit) const
+ {
+  auto radius2 = radius * radius;
+  ForEachInRect(x - radius, y - radius, x + radius, y + radius, [&](int index, double px, double py) {
+   auto dx = px - x;
+   auto dy = py - y;
+   if (dx * dx + dy * dy <= radius2)
+   {
+    visit(index, px, py);
+   }
+  });
+ }
+
+ /**
+  * Number of points in the grid
+  * @return Point count from the last Build
+  */
+ size_t GetCount() const { return mIndices.size(); }
+
+ /**
+  * Size of a cell
+  * @return Cell width and height in pixels
+  */
+ double GetCellSize() const { return mCellSize; }
+
+ /**
+  * Number of cells across
+  * @return Column count
+  */
+ int GetColumns() const { return mColumns; }
+
+ /**
+  * Number of cells down
+  * @return Row count
+  */
+ int GetRows() const { return mRows; }
+};
+
+#endif //AQUARIUM_SPATIALGRID_H
@@ -0,0 +1,75 @@
+/**
+ * @file SpeciesFish.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SpeciesTraits and SpeciesFish class templates.
+ *
+ * Each species of fish is the same Fish with different constants,
+ * so the constants are traits and the species types are made from
+ * them by one template.
+ */
+
+#ifndef AQUARIUM_SPECIESFISH_H
+#define AQUARIUM_SPECIESFISH_H
+
+#include "Fish.h"
+
+/**
+ * What sets a species apart, known at compile time.
+ *
+ * Each species specializes this next to its typedef, such as
+ * FishBeta in FishBeta.h, with:
+ *
+ *  - Type, the name it is saved under and created from
+ *  - Image, the sprite it is drawn with
+ *  - MinSpeedX, MaxSpeedX, MinSpeedY and MaxSpeedY, the range
+ *    its starting speed is picked from in pixels per second
+ *
+ * @tparam Species The species
+ */
+template <FishSpecies Species>
+struct SpeciesTraits;
+
+/**
+ * A fish of one species.
+ *
+ * Nothing here is virtual: the species only decides what the
+ * fish starts out as, and from then on its entity is moved by the
+ * world's systems like any other fish.
+ *
+ * @tparam Species The species, with a SpeciesTraits specialization
+ */
+template <FishSpecies Species>
+class SpeciesFish : public Fish {
+public:
+ /// The traits of the species
+ typedef SpeciesTraits<Species> Traits;
+
+ /// Name the species is saved under
+ static constexpr const wchar_t *Type = Traits::Type;
+
+ static_assert(Traits::MinSpeedX <= Traits::MaxSpeedX && Traits::MinSpeedY <= Traits::MaxSpeedY,
+     "Speed ranges must not be empty");
+
+ /// Default constructor (disabled)
+ SpeciesFish() = delete;
+
+ /// Copy constructor (disabled)
+ SpeciesFish(const SpeciesFish &) = delete;
+
+ /// Assignment operator
+ void operator=(const SpeciesFish &) = delete;
+
+ /**
+  * Constructor
+  * @param aquarium Aquarium this fish is a member of
+  */
+ explicit SpeciesFish(Aquarium *aquarium) : Fish(aquarium, Traits::Image)
+ {
+  SetRandomSpeed(Traits::MinSpeedX, Traits::MaxSpeedX, Traits::MinSpeedY, Traits::MaxSpeedY);
+  SetSpecies(Species);
+  SetType(Traits::Type);
+ }
+};
+
+#endif //AQUARIUM_SPECIESFISH_H
@@ -0,0 +1,75 @@
+/**
+ * @file Sprite.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the Sprite class.
+ */
+
+#include "pch.h"
+#include "Sprite.h"
+
+using namespace std;
+
+/// Bytes per pixel we assume a display bitmap uses (32 bit RGBA)
+const size_t BitmapBytesPerPixel = 4;
+
+/**
+ * Constructor
+ *
+ * Builds both orientations up front so mirroring an item never
+ * has to allocate.
+ *
+ * @param id Id the cache gave this sprite
+ * @param filename The image file this sprite was loaded from
+ * @param image The decoded image
+ */
+Sprite::Sprite(int id, const std::wstring &filename, const wxImage &image) :
+    mId(id), mFilename(filename), mImage(image), mBitmap(image),
+    mMirrorImage(image.Mirror()), mMirrorBitmap(mMirrorImage)
+{
+ int wid = image.GetWidth();
+ int hit = image.GetHeight();
+
+ if (image.HasAlpha())
+ {
+  mHitMask = HitMask::FromAlpha(wid, hit, image.GetAlpha(), wxIMAGE_ALPHA_THRESHOLD);
+ }
+ else
+ {
+  // No alpha channel, let the image decide (it may have a mask colour)
+  mHitMask = HitMask(wid, hit);
+  for (int y = 0; y < hit; y++)
+  {
+   for (int x = 0; x < wid; x++)
+   {
+    if (!image.IsTransparent(x, y))
+    {
+     mHitMask.Set(x, y);
+    }
+   }
+  }
+ }
+
+ mMirrorHitMask = mHitMask.Mirror();
+}
+
+/**
+ * Estimate of the memory this sprite keeps resident.
+ *
+ * Counts the RGB and alpha planes of the image, the pixels of
+ * the display bitmap and the hit mask, for both orientations.
+ *
+ * @return Size in bytes
+ */
+size_t Sprite::GetResidentBytes() const
+{
+ size_t pixels = size_t(mImage.GetWidth()) * size_t(mImage.GetHeight());
+
+ size_t bytes = pixels * 3;
+ if (mImage.HasAlpha())
+ {
+  bytes += pixels;
+ }
+
+ return (bytes + pixels * BitmapBytesPerPixel + mHitMask.GetBytes()) * 2;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Sprite.h
+ * @author Yeji Lee
+ *
+ * Declaration of the Sprite class.
+ *
+ * A sprite is the decoded image for one image file along with the
+ * bitmaps and hit masks for it, in both the normal and mirrored orientation.
+ * Sprites are created by the SpriteCache and shared by every item that
+ * uses the same image file.
+ */
+
+#ifndef AQUARIUM_SPRITE_H
+#define AQUARIUM_SPRITE_H
+
+#include <string>
+#include "HitMask.h"
+
+/**
+ * Shared, immutable image data for an item.
+ *
+ * Once constructed a sprite is never changed, so any number of
+ * items can hold on to the same one.
+ */
+class Sprite {
+private:
+ /// Small integer id, unique for every sprite the cache creates
+ int mId;
+
+ /// The image file this sprite was loaded from
+ std::wstring mFilename;
+
+ /// The decoded image
+ wxImage mImage;
+
+ /// The bitmap we can display for this image
+ wxBitmap mBitmap;
+
+ /// The decoded image flipped left to right
+ wxImage mMirrorImage;
+
+ /// The bitmap for the mirrored image
+ wxBitmap mMirrorBitmap;
+
+ /// Opaque pixels of the image
+ HitMask mHitMask;
+
+ /// Opaque pixels of the mirrored image
+ HitMask mMirrorHitMask;
+
+public:
+ Sprite(int id, const std::wstring &filename, const wxImage &image);
+
+ /// Default constructor (disabled)
+ Sprite() = delete;
+
+ /// Copy constructor (disabled)
+ Sprite(const Sprite &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const Sprite &) = delete;
+
+ /**
+  * The id of this sprite
+  * @return Id, usable as an index into per-sprite tables
+  */
+ int GetId() const { return mId; }
+
+ /**
+  * The image file this sprite was loaded from
+  * @return Filename as given to the cache
+  */
+ const std::wstring &GetFilename() const { return mFilename; }
+
+ /**
+  * The decoded image
+  * @param mirror True to get the mirrored orientation
+  * @return Reference to the image
+  */
+ const wxImage &GetImage(bool mirror = false) const { return mirror ? mMirrorImage : mImage; }
+
+ /**
+  * The bitmap we draw this sprite with
+  * @param mirror True to get the mirrored orientation
+  * @return Reference to the bitmap
+  */
+ const wxBitmap &GetBitmap(bool mirror = false) const { return mirror ? mMirrorBitmap : mBitmap; }
+
+ /**
+  * The opacity mask we hit test this sprite with
+  * @param mirror True to get the mirrored orientation
+  * @return Reference to the mask
+  */
+ const HitMask &GetHitMask(bool mirror = false) const { return mirror ? mMirrorHitMask : mHitMask; }
+
+ /**
+  * Width of the sprite
+  * @return Width in pixels
+  */
+ int GetWidth() const { return mImage.GetWidth(); }
+
+ /**
+  * Height of the sprite
+  * @return Height in pixels
+  */
+ int GetHeight() const { return mImage.GetHeight(); }
+
+ size_t GetResidentBytes() const;
+};
+
+#endif //AQUARIUM_SPRITE_H
@@ -0,0 +1,152 @@
+/**
+ * @file SpriteAtlas.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SpriteAtlas class.
+ */
+
+#include "pch.h"
+#include "SpriteAtlas.h"
+#include "Sprite.h"
+#include <wx/dcmemory.h>
+#include <cstring>
+
+using namespace std;
+
+/// Widest we let the atlas get in pixels
+const int MaxAtlasWidth = 2048;
+
+/// Empty pixels between sprites in the atlas
+const int AtlasPadding = 1;
+
+/**
+ * Copy an image into the atlas image
+ * @param atlas Atlas image, must have an alpha channel
+ * @param image Image to copy
+ * @param rect Where in the atlas it goes
+ */
+static void CopyInto(wxImage &atlas, const wxImage &image, const AtlasRect &rect)
+{
+ auto atlasRGB = atlas.GetData();
+ auto atlasAlpha = atlas.GetAlpha();
+ auto imageRGB = image.GetData();
+ auto imageAlpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+ size_t atlasWid = atlas.GetWidth();
+
+ for (int y = 0; y < rect.height; y++)
+ {
+  size_t to = (rect.y + y) * atlasWid + rect.x;
+  size_t from = size_t(y) * rect.width;
+
+  memcpy(atlasRGB + to * 3, imageRGB + from * 3, size_t(rect.width) * 3);
+  if (imageAlpha != nullptr)
+  {
+   memcpy(atlasAlpha + to, imageAlpha + from, rect.width);
+  }
+  else
+  {
+   memset(atlasAlpha + to, wxALPHA_OPAQUE, rect.width);
+  }
+ }
+}
+
+/**
+ * Constructor
+ *
+ * Packs every sprite and its mirrored image into one image
+ * and creates the bitmap for it.
+ *
+ * @param sprites The sprites to put in the atlas
+ */
+SpriteAtlas::SpriteAtlas(const std::vector<std::shared_ptr<const Sprite>> &sprites)
+{
+ AtlasPacker packer(MaxAtlasWidth, AtlasPadding);
+
+ vector<int> normal;
+ vector<int> mirror;
+ for (auto &sprite : sprites)
+ {
+  normal.push_back(packer.Add(sprite->GetWidth(), sprite->GetHeight()));
+  mirror.push_back(packer.Add(sprite->GetWidth(), sprite->GetHeight()));
+ }
+
+ if (sprites.empty() || !packer.Pack())
+ {
+  return;
+ }
+
+ mImage = wxImage(packer.GetWidth(), packer.GetHeight(), true);
+ mImage.InitAlpha();
+ memset(mImage.GetAlpha(), wxALPHA_TRANSPARENT, size_t(mImage.GetWidth()) * mImage.GetHeight());
+
+ for (size_t i = 0; i < sprites.size(); i++)
+ {
+  auto &sprite = *sprites[i];
+
+  Region region;
+  region.valid = true;
+  region.normal = packer.GetRect(normal[i]);
+  region.mirror = packer.GetRect(mirror[i]);
+
+  CopyInto(mImage, sprite.GetImage(false), region.normal);
+  CopyInto(mImage, sprite.GetImage(true), region.mirror);
+
+  if (sprite.GetId() >= (int)mRegions.size())
+  {
+   mRegions.resize(sprite.GetId() + 1);
+  }
+  mRegions[sprite.GetId()] = region;
+ }
+
+ mBitmap = wxBitmap(mImage);
+}
+
+/**
+ * Destructor
+ */
+SpriteAtlas::~SpriteAtlas()
+{
+}
+
+/**
+ * Is a sprite in this atlas?
+ * @param sprite Sprite to look for
+ * @return true if the sprite can be drawn from the atlas
+ */
+bool SpriteAtlas::Contains(const Sprite &sprite) const
+{
+ auto id = sprite.GetId();
+ return id >= 0 && id < (int)mRegions.size() && mRegions[id].valid;
+}
+
+/**
+ * Where a sprite lives in the atlas
+ * @param sprite Sprite to look up, must be in the atlas
+ * @param mirror True for the mirrored orientation
+ * @return Sub-rectangle of the atlas
+ */
+const AtlasRect &SpriteAtlas::GetRegion(const Sprite &sprite, bool mirror) const
+{
+ auto &region = mRegions[sprite.GetId()];
+ return mirror ? region.mirror : region.normal;
+}
+
+/**
+ * Draw a sprite from the atlas
+ * @param dc Device context to draw on
+ * @param sprite Sprite to draw, must be in the atlas
+ * @param mirror True to draw the mirrored orientation
+ * @param x Left edge to draw at
+ * @param y Top edge to draw at
+ */
+void SpriteAtlas::Draw(wxDC *dc, const Sprite &sprite, bool mirror, int x, int y) const
+{
+ if (mSource == nullptr)
+ {
+  mSource = make_unique<wxMemoryDC>();
+  mSource->SelectObjectAsSource(mBitmap);
+ }
+
+ auto &rect = GetRegion(sprite, mirror);
+ dc->Blit(x, y, rect.width, rect.height, mSource.get(), rect.x, rect.y, wxCOPY, true);
+}
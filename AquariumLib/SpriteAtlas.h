@@ -0,0 +1,88 @@
+/**
+ * @file SpriteAtlas.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SpriteAtlas class.
+ *
+ * Every sprite, in both orientations, packed into one large
+ * image so items can all be drawn from a single bitmap.
+ */
+
+#ifndef AQUARIUM_SPRITEATLAS_H
+#define AQUARIUM_SPRITEATLAS_H
+
+#include <memory>
+#include <vector>
+#include "AtlasPacker.h"
+
+class Sprite;
+class wxMemoryDC;
+
+/**
+ * One image holding many sprites, with a lookup from sprite
+ * to the sub-rectangle it occupies.
+ *
+ * An atlas is built once and never changes. It has to be
+ * built and drawn on the GUI thread since it owns a bitmap.
+ */
+class SpriteAtlas {
+private:
+ /// Where one sprite lives in the atlas
+ struct Region {
+  bool valid = false;   ///< True if the sprite is in the atlas
+  AtlasRect normal;     ///< The sprite as loaded
+  AtlasRect mirror;     ///< The sprite mirrored
+ };
+
+ /// The packed image
+ wxImage mImage;
+
+ /// The bitmap we draw from
+ wxBitmap mBitmap;
+
+ /// Regions indexed by sprite id
+ std::vector<Region> mRegions;
+
+ /// Device context with the atlas bitmap selected, created on first draw
+ mutable std::unique_ptr<wxMemoryDC> mSource;
+
+public:
+ explicit SpriteAtlas(const std::vector<std::shared_ptr<const Sprite>> &sprites);
+ ~SpriteAtlas();
+
+ /// Copy constructor (disabled)
+ SpriteAtlas(const SpriteAtlas &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const SpriteAtlas &) = delete;
+
+ bool Contains(const Sprite &sprite) const;
+ const AtlasRect &GetRegion(const Sprite &sprite, bool mirror) const;
+ void Draw(wxDC *dc, const Sprite &sprite, bool mirror, int x, int y) const;
+
+ /**
+  * The packed image
+  * @return Reference to the image
+  */
+ const wxImage &GetImage() const { return mImage; }
+
+ /**
+  * The bitmap everything is drawn from
+  * @return Reference to the bitmap
+  */
+ const wxBitmap &GetBitmap() const { return mBitmap; }
+
+ /**
+  * Width of the atlas
+  * @return Width in pixels
+  */
+ int GetWidth() const { return mImage.GetWidth(); }
+
+ /**
+  * Height of the atlas
+  * @return Height in pixels
+  */
+ int GetHeight() const { return mImage.GetHeight(); }
+};
+
+#endif //AQUARIUM_SPRITEATLAS_H
@@ -0,0 +1,340 @@
+/**
+ * @file SpriteCache.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the SpriteCache class.
+ */
+
+#include "pch.h"
+#include "SpriteCache.h"
+#include "Sprite.h"
+#include "SpriteAtlas.h"
+#include "EmbeddedAssets.h"
+#include "Log.h"
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+using namespace std;
+
+/// Sprites bigger than this in either direction (backgrounds) stay out of the atlas
+const int MaxAtlasSpriteSize = 512;
+
+/**
+ * Get the process-wide sprite cache
+ * @return Reference to the one and only cache
+ */
+SpriteCache &SpriteCache::Instance()
+{
+ static SpriteCache cache;
+ return cache;
+}
+
+/**
+ * Get the sprite for an image file, decoding it on first use.
+ *
+ * The lock is held while decoding so two callers asking for the
+ * same file at once still only decode it once. If the image is
+ * already being decoded by the AssetLoader we wait for that instead
+ * of decoding it a second time, and if it is compiled into the
+ * library we use those pixels and never touch the file.
+ *
+ * Sprites own bitmaps, so only the GUI thread may create them. Any
+ * other thread, once SetGuiThread has been called, gets a sprite
+ * that already exists or an empty stand in, never a new one.
+ *
+ * @param filename Path to the image file
+ * @return Shared sprite for that file
+ */
+std::shared_ptr<const Sprite> SpriteCache::Load(const std::wstring &filename)
+{
+ lock_guard<mutex> lock(mMutex);
+
+ auto found = mSprites.find(filename);
+ if (found != mSprites.end())
+ {
+  mHits++;
+  return found->second;
+ }
+
+ if (mGuiThread != thread::id() && this_thread::get_id() != mGuiThread)
+ {
+  AQUARIUM_LOG(Log::Level::Error, "Sprite " << wxString(filename).ToUTF8() << " was not made before it was needed");
+  return mMissing;
+ }
+
+ mMisses++;
+
+ wxImage image;
+ auto pending = mPending.find(filename);
+ auto embedded = FindEmbeddedAsset(filename);
+ if (pending != mPending.end())
+ {
+  // The decoding threads never take our lock, so waiting here is safe
+  image = *pending->second.get();
+  mPending.erase(pending);
+ }
+ else if (embedded != nullptr)
+ {
+  // Static data, the image uses the compiled in pixels without copying
+  // them. Sprites never modify their images, so the const_cast is safe.
+  image = wxImage(embedded->width, embedded->height,
+          const_cast<unsigned char *>(embedded->rgb),
+          const_cast<unsigned char *>(embedded->alpha), true);
+ }
+ else
+ {
+  image = wxImage(Resolve(mRoot, filename), wxBITMAP_TYPE_ANY);
+ }
+
+ auto sprite = make_shared<const Sprite>(mNextId++, filename, image);
+
+ mResidentBytes += sprite->GetResidentBytes();
+ mSprites[filename] = sprite;
+
+ return sprite;
+}
+
+/**
+ * Load every PNG image in a directory into the cache
+ * @param directory Directory to load from, such as L"images"
+ * @return Number of images found
+ */
+int SpriteCache::LoadDirectory(const std::wstring &directory)
+{
+ wxDir dir(ResolvePath(directory));
+ if (!dir.IsOpened())
+ {
+  return 0;
+ }
+
+ int count = 0;
+ wxString name;
+ for (bool found = dir.GetFirst(&name, L"*.png", wxDIR_FILES); found; found = dir.GetNext(&name))
+ {
+  Load(directory + L"/" + name.ToStdWstring());
+  count++;
+ }
+
+ return count;
+}
+
+/**
+ * Set the directory image paths are relative to.
+ *
+ * Items name their images relative to the directory holding the
+ * images folder, like L"images/beta.png". Setting the root lets
+ * that work no matter what the working directory is.
+ *
+ * @param root Directory holding the images folder, empty for the working directory
+ */
+void SpriteCache::SetRoot(const std::wstring &root)
+{
+ lock_guard<mutex> lock(mMutex);
+ mRoot = root;
+}
+
+/**
+ * Name the only thread that may create sprites.
+ *
+ * Call it on the GUI thread once every sprite the simulation
+ * thread may ask for is loaded. Also makes the empty stand in
+ * other threads get for a sprite nobody made.
+ *
+ * @param thread The GUI thread, or no thread to let any thread create sprites
+ */
+void SpriteCache::SetGuiThread(std::thread::id thread)
+{
+ lock_guard<mutex> lock(mMutex);
+ mGuiThread = thread;
+
+ if (mMissing == nullptr && thread != std::thread::id())
+ {
+  wxImage empty(1, 1);
+  empty.InitAlpha();
+  empty.SetAlpha(0, 0, wxIMAGE_ALPHA_TRANSPARENT);
+  // A real id, snapshots index their sprite tables by it
+  mMissing = make_shared<const Sprite>(mNextId++, L"", empty);
+ }
+}
+
+/**
+ * Turn an image path as items use it into one we can open.
+ *
+ * Takes the lock, so do not call it with the lock held, and do not
+ * call it from threads Load may be waiting on (see AssetLoader).
+ *
+ * @param filename Path relative to the root
+ * @return Path to open
+ */
+std::wstring SpriteCache::ResolvePath(const std::wstring &filename) const
+{
+ lock_guard<mutex> lock(mMutex);
+ return Resolve(mRoot, filename);
+}
+
+/**
+ * Turn an image path as items use it into one we can open
+ * @param root Directory holding the images folder, empty for the working directory
+ * @param filename Path relative to the root
+ * @return Path to open
+ */
+std::wstring SpriteCache::Resolve(const std::wstring &root, const std::wstring &filename)
+{
+ if (root.empty() || wxFileName(filename).IsAbsolute())
+ {
+  return filename;
+ }
+
+ return root + L"/" + filename;
+}
+
+/**
+ * Hand the cache an image that is being decoded on another thread
+ * @param filename Path the image will be requested by
+ * @param image Future that will hold the decoded image
+ */
+void SpriteCache::AddPending(const std::wstring &filename, std::shared_future<std::shared_ptr<wxImage>> image)
+{
+ lock_guard<mutex> lock(mMutex);
+ if (mSprites.find(filename) == mSprites.end())
+ {
+  mPending[filename] = image;
+ }
+}
+
+/**
+ * Turn every pending image into a sprite, waiting for any still
+ * being decoded. Must be called on the GUI thread.
+ * @return Number of sprites created
+ */
+int SpriteCache::LoadPending()
+{
+ vector<wstring> filenames;
+ {
+  lock_guard<mutex> lock(mMutex);
+  for (auto &pending : mPending)
+  {
+   filenames.push_back(pending.first);
+  }
+ }
+
+ for (auto &filename : filenames)
+ {
+  Load(filename);
+ }
+
+ return (int)filenames.size();
+}
+
+/**
+ * Create sprites for every image compiled into the library.
+ * Must be called on the GUI thread.
+ * @return Number of embedded images, 0 if the build has none
+ */
+int SpriteCache::LoadEmbedded()
+{
+ auto count = GetEmbeddedAssetCount();
+ for (size_t i = 0; i < count; i++)
+ {
+  Load(GetEmbeddedAsset(i)->name);
+ }
+
+ return (int)count;
+}
+
+/**
+ * Pack the cached sprites into a new atlas.
+ *
+ * Sprites too large to be worth packing, like the background,
+ * are left out and keep drawing from their own bitmaps. Items
+ * drawn before this is called also use their own bitmaps.
+ */
+void SpriteCache::BuildAtlas()
+{
+ vector<shared_ptr<const Sprite>> sprites;
+ {
+  lock_guard<mutex> lock(mMutex);
+  for (auto &entry : mSprites)
+  {
+   auto &sprite = entry.second;
+   if (sprite->GetWidth() <= MaxAtlasSpriteSize && sprite->GetHeight() <= MaxAtlasSpriteSize)
+   {
+    sprites.push_back(sprite);
+   }
+  }
+ }
+
+ // Build outside the lock, it copies a lot of pixels
+ auto atlas = make_shared<const SpriteAtlas>(sprites);
+
+ lock_guard<mutex> lock(mMutex);
+ mAtlas = atlas;
+}
+
+/**
+ * Get the current sprite atlas
+ * @return The atlas or nullptr if none has been built
+ */
+std::shared_ptr<const SpriteAtlas> SpriteCache::GetAtlas() const
+{
+ lock_guard<mutex> lock(mMutex);
+ return mAtlas;
+}
+
+/**
+ * Drop every cached sprite and reset the counters.
+ *
+ * Items that still hold a sprite keep it alive, the cache
+ * just stops handing it out.
+ */
+void SpriteCache::Clear()
+{
+ lock_guard<mutex> lock(mMutex);
+
+ mSprites.clear();
+ mPending.clear();
+ mAtlas = nullptr;
+ mHits = 0;
+ mMisses = 0;
+ mResidentBytes = 0;
+}
+
+/**
+ * Number of requests satisfied without decoding
+ * @return Hit count
+ */
+size_t SpriteCache::GetHits() const
+{
+ lock_guard<mutex> lock(mMutex);
+ return mHits;
+}
+
+/**
+ * Number of requests that decoded an image
+ * @return Miss count
+ */
+size_t SpriteCache::GetMisses() const
+{
+ lock_guard<mutex> lock(mMutex);
+ return mMisses;
+}
+
+/**
+ * Memory held by the cached sprites
+ * @return Size in bytes
+ */
+size_t SpriteCache::GetResidentBytes() const
+{
+ lock_guard<mutex> lock(mMutex);
+ return mResidentBytes;
+}
+
+/**
+ * Number of distinct sprites in the cache
+ * @return Sprite count
+ */
+size_t SpriteCache::GetCount() const
+{
+ lock_guard<mutex> lock(mMutex);
+ return mSprites.size();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file SpriteCache.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SpriteCache class.
+ *
+ * Process-wide cache of decoded sprites keyed by image path, so an
+ * image file is decoded once no matter how many items use it. The
+ * cache also owns the sprite atlas built from the sprites it holds.
+ */
+
+#ifndef AQUARIUM_SPRITECACHE_H
+#define AQUARIUM_SPRITECACHE_H
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Sprite;
+class SpriteAtlas;
+
+/**
+ * Cache of sprites shared by every item in every aquarium.
+ *
+ * The first request for an image file decodes it, later requests
+ * are handed the same immutable sprite. Images can also be decoded
+ * ahead of time on other threads (see AssetLoader) and handed to the
+ * cache as pending images, which the first request then picks up.
+ * Images compiled into the library (see EmbeddedAssets.h) are used
+ * in place of the files without decoding anything.
+ *
+ * Sprites own bitmaps, which only the GUI thread may create. Once
+ * SetGuiThread has named it, other threads, like the simulation
+ * thread creating items, are only handed sprites that already
+ * exist, so the application makes every sprite up front.
+ */
+class SpriteCache {
+private:
+ /// Protects everything below
+ mutable std::mutex mMutex;
+
+ /// The loaded sprites, keyed by image path
+ std::map<std::wstring, std::shared_ptr<const Sprite>> mSprites;
+
+ /// Images being decoded elsewhere that have no sprite yet
+ std::map<std::wstring, std::shared_future<std::shared_ptr<wxImage>>> mPending;
+
+ /// Directory image paths are relative to, empty for the working directory
+ std::wstring mRoot;
+
+ /// Number of requests satisfied from the cache
+ size_t mHits = 0;
+
+ /// Number of requests that had to decode an image
+ size_t mMisses = 0;
+
+ /// Memory held by the cached sprites in bytes
+ size_t mResidentBytes = 0;
+
+ /// Id to give the next sprite we create
+ int mNextId = 0;
+
+ /// Atlas of the cached sprites, if one has been built
+ std::shared_ptr<const SpriteAtlas> mAtlas;
+
+ /// Only thread that may create sprites, none to let any thread
+ std::thread::id mGuiThread;
+
+ /// Handed to other threads asking for a sprite nobody made
+ std::shared_ptr<const Sprite> mMissing;
+
+ /// Constructor, use Instance() instead
+ SpriteCache() = default;
+
+ static std::wstring Resolve(const std::wstring &root, const std::wstring &filename);
+
+public:
+ /// Copy constructor (disabled)
+ SpriteCache(const SpriteCache &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const SpriteCache &) = delete;
+
+ static SpriteCache &Instance();
+
+ std::shared_ptr<const Sprite> Load(const std::wstring &filename);
+ int LoadDirectory(const std::wstring &directory);
+
+ void SetRoot(const std::wstring &root);
+ void SetGuiThread(std::thread::id thread = std::this_thread::get_id());
+ std::wstring ResolvePath(const std::wstring &filename) const;
+
+ void AddPending(const std::wstring &filename, std::shared_future<std::shared_ptr<wxImage>> image);
+ int LoadPending();
+ int LoadEmbedded();
+
+ void BuildAtlas();
+ std::shared_ptr<const SpriteAtlas> GetAtlas() const;
+
+ void Clear();
+
+ size_t GetHits() const;
+ size_t GetMisses() const;
+ size_t GetResidentBytes() const;
+ size_t GetCount() const;
+};
+
+#endif //AQUARIUM_SPRITECACHE_H
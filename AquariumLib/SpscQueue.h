@@ -0,0 +1,111 @@
+/**
+ * @file SpscQueue.h
+ * @author Yeji Lee
+ *
+ * Declaration of the SpscQueue class template.
+ *
+ * Bounded lock-free queue for exactly one producer thread and
+ * one consumer thread.
+ */
+
+#ifndef AQUARIUM_SPSCQUEUE_H
+#define AQUARIUM_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Single producer, single consumer ring buffer.
+ *
+ * Both sides are wait-free: a push or pop is a couple of loads
+ * and one store, and a push into a full queue fails at once
+ * rather than waiting for room. Each index is only written by
+ * its own side and sits on its own cache line.
+ *
+ * @tparam T Type of the values, must be default constructible and movable
+ */
+template <typename T>
+class SpscQueue {
+private:
+ /// Ring of values, a power of two in size
+ std::vector<T> mSlots;
+
+ /// Size minus one, for wrapping an index
+ size_t mMask;
+
+ /// Count of values popped, written by the consumer only
+ alignas(64) std::atomic<size_t> mHead{0};
+
+ /// Count of values pushed, written by the producer only
+ alignas(64) std::atomic<size_t> mTail{0};
+
+public:
+ /**
+  * Constructor
+  * @param capacity Most values the queue holds, rounded up to a power of two
+  */
+ explicit SpscQueue(size_t capacity)
+ {
+  size_t size = 1;
+  while (size < capacity)
+  {
+   size *= 2;
+  }
+
+  mSlots.resize(size);
+  mMask = size - 1;
+ }
+
+ /// Copy constructor (disabled)
+ SpscQueue(const SpscQueue &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const SpscQueue &) = delete;
+
+ /**
+  * Add a value to the back of the queue. Producer thread only.
+  * @param value Value to add, moved from only if there is room
+  * @return false if the queue is full
+  */
+ bool TryPush(T &&value)
+ {
+  auto tail = mTail.load(std::memory_order_relaxed);
+  if (tail - mHead.load(std::memory_order_acquire) > mMask)
+  {
+   return false;
+  }
+
+  mSlots[tail & mMask] = std::move(value);
+  mTail.store(tail + 1, std::memory_order_release);
+  return true;
+ }
+
+ /**
+  * Take the value at the front of the queue. Consumer thread only.
+  * @param value Receives the value
+  * @return false if the queue is empty
+  */
+ bool TryPop(T &value)
+ {
+  auto head = mHead.load(std::memory_order_relaxed);
+  if (head == mTail.load(std::memory_order_acquire))
+  {
+   return false;
+  }
+
+  value = std::move(mSlots[head & mMask]);
+  mSlots[head & mMask] = T();
+  mHead.store(head + 1, std::memory_order_release);
+  return true;
+ }
+
+ /**
+  * Most values the queue can hold
+  * @return Capacity
+  */
+ size_t GetCapacity() const { return mSlots.size(); }
+};
+
+#endif //AQUARIUM_SPSCQUEUE_H
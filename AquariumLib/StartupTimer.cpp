@@ -0,0 +1,50 @@
+/**
+ * @file StartupTimer.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the StartupTimer class.
+ */
+
+#include "pch.h"
+#include "StartupTimer.h"
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+/// When the process started
+static const steady_clock::time_point ProcessStart = steady_clock::now();
+
+/// Time from process start to the first frame in nanoseconds, 0 until painted
+static atomic<long long> ColdStartNanoseconds{0};
+
+/**
+ * Record that the first frame has been painted. Only the
+ * first call counts.
+ */
+void StartupTimer::MarkFirstFrame()
+{
+ auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - ProcessStart).count();
+
+ long long expected = 0;
+ ColdStartNanoseconds.compare_exchange_strong(expected, max<long long>(elapsed, 1));
+}
+
+/**
+ * Has the first frame been painted yet?
+ * @return true once MarkFirstFrame() has been called
+ */
+bool StartupTimer::HasFirstFrame()
+{
+ return ColdStartNanoseconds != 0;
+}
+
+/**
+ * Cold start time
+ * @return Seconds from process start to the first painted frame, or 0 if none yet
+ */
+double StartupTimer::GetColdStartSeconds()
+{
+ return ColdStartNanoseconds * 1e-9;
+}
@@ -0,0 +1,27 @@
+/**
+ * @file StartupTimer.h
+ * @author Yeji Lee
+ *
+ * Declaration of the StartupTimer class.
+ *
+ * Measures cold start time, from process start to the first
+ * frame painted in the aquarium view.
+ */
+
+#ifndef AQUARIUM_STARTUPTIMER_H
+#define AQUARIUM_STARTUPTIMER_H
+
+/**
+ * Cold start metric.
+ *
+ * The start time is taken during static initialization of the
+ * library, which is as close to process start as we can portably get.
+ */
+class StartupTimer {
+public:
+ static void MarkFirstFrame();
+ static bool HasFirstFrame();
+ static double GetColdStartSeconds();
+};
+
+#endif //AQUARIUM_STARTUPTIMER_H
@@ -0,0 +1,86 @@
+/**
+ * @file StaticLayer.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the StaticLayer class.
+ */
+
+#include "pch.h"
+#include "StaticLayer.h"
+#include "Snapshot.h"
+#include "Sprite.h"
+#include "SpriteCache.h"
+#include "SpriteAtlas.h"
+#include "Item.h"
+
+using namespace std;
+
+/**
+ * Constructor
+ */
+StaticLayer::StaticLayer()
+{
+}
+
+/**
+ * Destructor
+ */
+StaticLayer::~StaticLayer()
+{
+}
+
+/**
+ * Draw the static part of a snapshot, redrawing the layer first
+ * if the snapshot's static items are not the ones it holds
+ * @param dc Device context to draw on
+ * @param snapshot Snapshot being drawn
+ */
+void StaticLayer::Draw(wxDC *dc, const Snapshot &snapshot)
+{
+ auto background = snapshot.GetBackground().get();
+ if (background == nullptr)
+ {
+  return;
+ }
+
+ if (mBitmap == nullptr || snapshot.GetStaticVersion() != mVersion ||
+         snapshot.GetStaticCount() != mCount || background != mBackground)
+ {
+  Build(snapshot);
+ }
+
+ dc->DrawBitmap(*mBitmap, 0, 0);
+}
+
+/**
+ * Draw the background, title and static entries into the layer
+ * @param snapshot Snapshot to take them from
+ */
+void StaticLayer::Build(const Snapshot &snapshot)
+{
+ auto &background = *snapshot.GetBackground();
+ if (mBitmap == nullptr || mBitmap->GetWidth() != background.GetWidth() ||
+         mBitmap->GetHeight() != background.GetHeight())
+ {
+  mBitmap = make_unique<wxBitmap>(background.GetWidth(), background.GetHeight());
+ }
+
+ wxMemoryDC dc(*mBitmap);
+ dc.DrawBitmap(background.GetBitmap(), 0, 0);
+ Snapshot::DrawTitle(&dc);
+
+ auto atlas = SpriteCache::Instance().GetAtlas();
+ auto &entries = snapshot.GetEntries();
+ for (size_t i = 0; i < snapshot.GetStaticCount(); i++)
+ {
+  auto &entry = entries[i];
+  Item::DrawSprite(&dc, snapshot.GetSprite(entry.sprite), entry.mirror, entry.x, entry.y, atlas.get());
+ }
+
+ dc.SelectObject(wxNullBitmap);
+
+ mVersion = snapshot.GetStaticVersion();
+ mCount = snapshot.GetStaticCount();
+ mBackground = &background;
+ mBuilds++;
+}
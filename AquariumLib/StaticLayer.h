@@ -0,0 +1,63 @@
+/**
+ * @file StaticLayer.h
+ * @author Yeji Lee
+ *
+ * Declaration of the StaticLayer class.
+ *
+ * The background, title and decor behind every fish, drawn once
+ * into a bitmap and reused for each frame until one of them changes.
+ */
+
+#ifndef AQUARIUM_STATICLAYER_H
+#define AQUARIUM_STATICLAYER_H
+
+#include <cstdint>
+#include <memory>
+
+class Snapshot;
+class Sprite;
+
+/**
+ * A cached bitmap of the part of a Snapshot that does not move.
+ *
+ * A snapshot says how many of its first entries are static and
+ * carries a version that the aquarium bumps whenever a static item
+ * is added, moved or reordered. The layer is redrawn only when the
+ * version, the count or the background is different from last
+ * time, so a tank full of decor costs one bitmap draw per frame.
+ *
+ * Only for use on the GUI thread.
+ */
+class StaticLayer {
+private:
+ /// The composited layer
+ std::unique_ptr<wxBitmap> mBitmap;
+
+ /// Static version of the snapshot the layer was drawn from
+ uint64_t mVersion = 0;
+
+ /// Number of entries drawn into the layer
+ size_t mCount = 0;
+
+ /// Background the layer was drawn on
+ const Sprite *mBackground = nullptr;
+
+ /// Number of times the layer has been drawn
+ int mBuilds = 0;
+
+ void Build(const Snapshot &snapshot);
+
+public:
+ StaticLayer();
+ ~StaticLayer();
+
+ void Draw(wxDC *dc, const Snapshot &snapshot);
+
+ /**
+  * Number of times the layer has been redrawn
+  * @return Build count
+  */
+ int GetBuilds() const { return mBuilds; }
+};
+
+#endif //AQUARIUM_STATICLAYER_H
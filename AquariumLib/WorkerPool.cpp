@@ -0,0 +1,141 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Yeji Lee
+ *
+ * Implementation of the WorkerPool class.
+ */
+
+#include "pch.h"
+#include "WorkerPool.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Constructor, starts the workers
+ * @param threads Number of threads to run jobs on, including the caller of Run
+ */
+WorkerPool::WorkerPool(int threads)
+{
+ for (int i = 1; i < threads; i++)
+ {
+  mThreads.emplace_back(&WorkerPool::Worker, this);
+ }
+}
+
+/**
+ * Destructor, stops the workers
+ */
+WorkerPool::~WorkerPool()
+{
+ {
+  lock_guard<mutex> lock(mMutex);
+  mStop = true;
+ }
+ mWake.notify_all();
+
+ for (auto &thread : mThreads)
+ {
+  thread.join();
+ }
+}
+
+/**
+ * Get the process-wide pool, one thread per hardware thread
+ * @return Reference to the pool
+ */
+WorkerPool &WorkerPool::Instance()
+{
+ static WorkerPool pool(max(1, (int)thread::hardware_concurrency()));
+ return pool;
+}
+
+/**
+ * Run a job over a range, split into chunks.
+ *
+ * Returns once every chunk is done. The calling thread works on
+ * chunks too, and does them all itself when the pool has no
+ * workers or the range is a single chunk.
+ *
+ * @param count Size of the range, the job sees indices 0 to count - 1
+ * @param chunk Most indices to give the job at once
+ * @param job Function to call for each chunk
+ */
+void WorkerPool::Run(size_t count, size_t chunk, const Job &job)
+{
+ chunk = max<size_t>(chunk, 1);
+ if (mThreads.empty() || count <= chunk)
+ {
+  for (size_t begin = 0; begin < count; begin += chunk)
+  {
+   job(begin, min(begin + chunk, count));
+  }
+  return;
+ }
+
+ lock_guard<mutex> run(mRunMutex);
+
+ {
+  lock_guard<mutex> lock(mMutex);
+  mJob = &job;
+  mCount = count;
+  mChunk = chunk;
+  mNext = 0;
+  mBusy = (int)mThreads.size();
+  mGeneration++;
+ }
+ mWake.notify_all();
+
+ Work();
+
+ unique_lock<mutex> lock(mMutex);
+ mDone.wait(lock, [this]() { return mBusy == 0; });
+ mJob = nullptr;
+}
+
+/**
+ * Take chunks of the current job until there are none left
+ */
+void WorkerPool::Work()
+{
+ for (;;)
+ {
+  auto begin = mNext.fetch_add(mChunk);
+  if (begin >= mCount)
+  {
+   return;
+  }
+
+  (*mJob)(begin, min(begin + mChunk, mCount));
+ }
+}
+
+/**
+ * Body of each worker thread
+ */
+void WorkerPool::Worker()
+{
+ uint64_t generation = 0;
+
+ for (;;)
+ {
+  {
+   unique_lock<mutex> lock(mMutex);
+   mWake.wait(lock, [&]() { return mStop || mGeneration != generation; });
+   if (mStop)
+   {
+    return;
+   }
+
+   generation = mGeneration;
+  }
+
+  Work();
+
+  lock_guard<mutex> lock(mMutex);
+  if (--mBusy == 0)
+  {
+   mDone.notify_one();
+  }
+ }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file WorkerPool.h
+ * @author Yeji Lee
+ *
+ * Declaration of the WorkerPool class.
+ *
+ * A set of threads that live as long as the program and split
+ * ranges of work, like the fish update, between them.
+ */
+
+#ifndef AQUARIUM_WORKERPOOL_H
+#define AQUARIUM_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Persistent pool of worker threads.
+ *
+ * Run cuts a range into chunks and hands them out to the workers
+ * and the calling thread until all are done. Which thread gets a
+ * chunk varies, so jobs must only touch their own part of the range.
+ */
+class WorkerPool {
+public:
+ /// A piece of work on the range [begin, end)
+ typedef std::function<void(size_t begin, size_t end)> Job;
+
+private:
+ /// The worker threads, not counting the thread that calls Run
+ std::vector<std::thread> mThreads;
+
+ /// Only one Run at a time
+ std::mutex mRunMutex;
+
+ /// Protects everything below
+ std::mutex mMutex;
+
+ /// Signals the workers that there is a new job or they should stop
+ std::condition_variable mWake;
+
+ /// Signals Run that the workers are finished
+ std::condition_variable mDone;
+
+ /// The job being run
+ const Job *mJob = nullptr;
+
+ /// Size of the range being run
+ size_t mCount = 0;
+
+ /// Size of each chunk
+ size_t mChunk = 0;
+
+ /// Start of the next chunk to hand out
+ std::atomic<size_t> mNext{0};
+
+ /// Number of workers still on the current job
+ int mBusy = 0;
+
+ /// Incremented for each job so workers know they have a new one
+ uint64_t mGeneration = 0;
+
+ /// True when the workers should exit
+ bool mStop = false;
+
+ void Worker();
+ void Work();
+
+public:
+ explicit WorkerPool(int threads);
+ ~WorkerPool();
+
+ /// Copy constructor (disabled)
+ WorkerPool(const WorkerPool &) = delete;
+
+ /// Assignment operator (disabled)
+ void operator=(const WorkerPool &) = delete;
+
+ static WorkerPool &Instance();
+
+ void Run(size_t count, size_t chunk, const Job &job);
+
+ /**
+  * Number of threads that run jobs, including the caller
+  * @return Thread count
+  */
+ int GetThreadCount() const { return (int)mThreads.size() + 1; }
+};
+
+#endif //AQUARIUM_WORKERPOOL_H
@@ -26,8 +26,11 @@ enum IDs {
  IDM_ADDFISHNEMO = wxID_HIGHEST + 2, // nemo fish
  IDM_ADDFISHDORY = wxID_HIGHEST + 3, // dory fish
  IDM_ADDDECORCASTLE = wxID_HIGHEST + 4, // Decor Castle
+ IDM_SCHOOLING = wxID_HIGHEST + 5, // Schooling on or off
  IDM_ADDFISHANGEL, // angel fish
- IDM_ADDFISHCARP // carp fish
+ IDM_ADDFISHCARP, // carp fish
+ IDM_RECORD, // start recording the session
+ IDM_STOPRECORDING // stop recording the session
 };
 
 
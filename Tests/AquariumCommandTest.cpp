@@ -0,0 +1,125 @@
+/**
+ * @file AquariumCommandTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for sending commands to the aquarium.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Aquarium.h>
+#include <Snapshot.h>
+
+using namespace std;
+
+/**
+ * Make a command
+ * @param type What to do
+ * @param item Item to do it to
+ * @param x X location
+ * @param y Y location
+ * @return The command
+ */
+static AquariumCommand MakeCommand(AquariumCommand::Type type, ItemHandle item = ItemHandle(), double x = 0, double y = 0)
+{
+ AquariumCommand command;
+ command.type = type;
+ command.item = item;
+ command.x = x;
+ command.y = y;
+ return command;
+}
+
+/**
+ * Commands do nothing until executed, then add, bring to
+ * front and clear items.
+ */
+TEST(AquariumCommandTest, Execute)
+{
+ Aquarium aquarium;
+
+ auto add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"beta";
+ ASSERT_TRUE(aquarium.Send(std::move(add)));
+ add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"castle";
+ ASSERT_TRUE(aquarium.Send(std::move(add)));
+ add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"shark";
+ ASSERT_TRUE(aquarium.Send(std::move(add)));
+ ASSERT_TRUE(aquarium.GetFishes().empty());
+
+ ASSERT_EQ(3, aquarium.ExecuteCommands());
+ ASSERT_EQ(2u, aquarium.GetFishes().size());
+
+ // Name the fish the way the GUI does, from a snapshot
+ Snapshot snapshot;
+ aquarium.Capture(snapshot);
+ auto fish = snapshot.GetEntries()[0].item;
+ ASSERT_EQ(aquarium.GetFishes()[0].get(), aquarium.Find(fish));
+
+ aquarium.Send(MakeCommand(AquariumCommand::Type::BringToFront, fish));
+ aquarium.ExecuteCommands();
+ ASSERT_EQ(fish, aquarium.GetFishes()[1]->GetHandle());
+
+ aquarium.Send(MakeCommand(AquariumCommand::Type::Clear));
+ aquarium.ExecuteCommands();
+ ASSERT_TRUE(aquarium.GetFishes().empty());
+
+ // Commands for an item that is gone are ignored
+ aquarium.Send(MakeCommand(AquariumCommand::Type::Move, fish, 10, 10));
+ ASSERT_EQ(1, aquarium.ExecuteCommands());
+}
+
+/**
+ * A run of moves of one item only carries out the last.
+ */
+TEST(AquariumCommandTest, CoalesceMoves)
+{
+ Aquarium aquarium;
+ auto add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"castle";
+ aquarium.Send(std::move(add));
+ add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"castle";
+ aquarium.Send(std::move(add));
+ aquarium.ExecuteCommands();
+
+ auto first = aquarium.GetFishes()[0].get();
+ auto second = aquarium.GetFishes()[1].get();
+
+ for (int i = 1; i <= 10; i++)
+ {
+  aquarium.Send(MakeCommand(AquariumCommand::Type::Move, first->GetHandle(), i, i * 2));
+ }
+ aquarium.Send(MakeCommand(AquariumCommand::Type::Move, second->GetHandle(), 50, 60));
+ aquarium.Send(MakeCommand(AquariumCommand::Type::Move, first->GetHandle(), 70, 80));
+
+ ASSERT_EQ(3, aquarium.ExecuteCommands());
+ ASSERT_NEAR(70, first->GetX(), 0.0001);
+ ASSERT_NEAR(80, first->GetY(), 0.0001);
+ ASSERT_NEAR(50, second->GetX(), 0.0001);
+ ASSERT_NEAR(60, second->GetY(), 0.0001);
+}
+
+/**
+ * A click lands on the top item in the snapshot.
+ */
+TEST(AquariumCommandTest, SnapshotHitTest)
+{
+ Aquarium aquarium;
+ auto add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"beta";
+ aquarium.Send(std::move(add));
+ add = MakeCommand(AquariumCommand::Type::Add);
+ add.name = L"beta";
+ aquarium.Send(std::move(add));
+ aquarium.ExecuteCommands();
+
+ Snapshot snapshot;
+ aquarium.Capture(snapshot);
+
+ // Both at the same place, the last one added is on top
+ ASSERT_EQ(aquarium.GetFishes()[1]->GetHandle(), snapshot.HitTest(200, 200));
+ ASSERT_TRUE(snapshot.HitTest(900, 700).IsNull());
+}
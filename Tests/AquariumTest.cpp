@@ -158,7 +158,7 @@ TEST_F(AquariumTest, HitTest)
     Aquarium aquarium;
 
     // Test hitting an empty aquarium
-    ASSERT_EQ(aquarium.HitTest(100, 200), nullptr) << L"Testing empty aquarium";
+    ASSERT_TRUE(aquarium.HitTest(100, 200).IsNull()) << L"Testing empty aquarium";
 
     // Create a FishBeta and add it to the aquarium
     auto fish1 = std::make_shared<FishBeta>(&aquarium);
@@ -166,10 +166,10 @@ TEST_F(AquariumTest, HitTest)
     fish1->SetLocation(100, 200);
 
     // Test hitting the fish at its location
-    ASSERT_TRUE(aquarium.HitTest(100, 200) == fish1) << L"Testing fish at 100, 200";
+    ASSERT_TRUE(aquarium.HitTest(100, 200) == fish1->GetHandle()) << L"Testing fish at 100, 200";
 
     // Test hitting a location where there is no fish
-    ASSERT_EQ(aquarium.HitTest(500, 500), nullptr) << L"Testing hit where there is no fish";
+    ASSERT_TRUE(aquarium.HitTest(500, 500).IsNull()) << L"Testing hit where there is no fish";
 }
 
 TEST_F(AquariumTest, HitTestOverlap)
@@ -193,18 +193,18 @@ TEST_F(AquariumTest, HitTestOverlap)
     // Test hitting the location where both fish are located
     auto hitItem = aquarium.HitTest(100, 200);
 
-    if (hitItem == fish2) {
+    if (hitItem == fish2->GetHandle()) {
         std::cout << "Correctly hit fish2 (on top)\n";
-    } else if (hitItem == fish1) {
+    } else if (hitItem == fish1->GetHandle()) {
         std::cout << "Incorrectly hit fish1 (on bottom)\n";
     } else {
-        std::cout << "Hit nothing (nullptr)\n";
+        std::cout << "Hit nothing (null handle)\n";
     }
 
-    ASSERT_TRUE(hitItem == fish2) << L"Testing fish2 is on top";
+    ASSERT_TRUE(hitItem == fish2->GetHandle()) << L"Testing fish2 is on top";
 
     // Test hitting a location where there is no fish
-    ASSERT_EQ(aquarium.HitTest(500, 500), nullptr) << L"Testing hit where there is no fish";
+    ASSERT_TRUE(aquarium.HitTest(500, 500).IsNull()) << L"Testing hit where there is no fish";
 }
 
 TEST_F(AquariumTest, Save) {
@@ -319,6 +319,37 @@ TEST_F(AquariumTest, Load) {
     TestAllTypes(file3);
 }
 
+TEST_F(AquariumTest, AddMany) {
+    Aquarium aquarium;
+
+    auto first = make_shared<DecorCastle>(&aquarium);
+    aquarium.Add(first);
+
+    vector<shared_ptr<Item>> items;
+    for (int i = 0; i < 1000; i++)
+    {
+        auto item = aquarium.Create(i % 2 ? L"nemo" : L"castle");
+        item->SetLocation(i, 2 * i);
+        items.push_back(item);
+    }
+    auto copy = items;
+    aquarium.AddMany(std::move(items));
+
+    // In order, in front of what was there, right where they were put
+    auto &fishes = aquarium.GetFishes();
+    ASSERT_EQ(1001u, fishes.size());
+    ASSERT_EQ(first, fishes[0]);
+    for (size_t i = 0; i < copy.size(); i++)
+    {
+        ASSERT_EQ(copy[i], fishes[i + 1]);
+        ASSERT_EQ(copy[i].get(), aquarium.Find(copy[i]->GetHandle()));
+        ASSERT_DOUBLE_EQ(double(i), fishes[i + 1]->GetX());
+        ASSERT_DOUBLE_EQ(2.0 * i, fishes[i + 1]->GetY());
+    }
+
+    ASSERT_EQ(500u, aquarium.GetFishStore().GetCount());
+}
+
 TEST_F(AquariumTest, FishBetaSpeedRange) {
     Aquarium aquarium;
 
@@ -0,0 +1,51 @@
+/**
+ * @file AssetLoaderTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the AssetLoader class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <AssetLoader.h>
+#include <SpriteCache.h>
+#include <Sprite.h>
+#include <atomic>
+
+/**
+ * The images directory is found from the working directory.
+ */
+TEST(AssetLoaderTest, FindRoot)
+{
+ ASSERT_EQ(L"", AssetLoader::FindRoot(L"images"));
+}
+
+/**
+ * Prefetched images become sprites without being decoded again.
+ */
+TEST(AssetLoaderTest, Prefetch)
+{
+ auto &cache = SpriteCache::Instance();
+ cache.Clear();
+
+ std::atomic<bool> done{false};
+ AssetLoader loader;
+ int count = loader.Start(L"images", [&done]() { done = true; });
+ ASSERT_GE(count, 7);
+
+ // Asking for one before the loader is done waits for its decode
+ auto beta = cache.Load(L"images/beta.png");
+ ASSERT_EQ(125, beta->GetWidth());
+
+ loader.Wait();
+ ASSERT_TRUE(done);
+
+ ASSERT_EQ(count - 1, cache.LoadPending());
+ ASSERT_EQ((size_t)count, cache.GetCount());
+ ASSERT_EQ((size_t)count, cache.GetMisses());
+
+ // Everything is a hit from now on
+ ASSERT_EQ(beta, cache.Load(L"images/beta.png"));
+ ASSERT_EQ(0, cache.LoadPending());
+ ASSERT_EQ(1u, cache.GetHits());
+}
@@ -0,0 +1,65 @@
+/**
+ * @file AtlasPackerTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the AtlasPacker class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <AtlasPacker.h>
+
+/**
+ * Do two placed rectangles overlap, counting the padding?
+ */
+static bool Overlap(const AtlasRect &a, const AtlasRect &b, int padding)
+{
+ return a.x < b.x + b.width + padding && b.x < a.x + a.width + padding &&
+        a.y < b.y + b.height + padding && b.y < a.y + a.height + padding;
+}
+
+/**
+ * Packed rectangles stay inside the atlas and never overlap.
+ */
+TEST(AtlasPackerTest, Pack)
+{
+ const int padding = 1;
+ AtlasPacker packer(300, padding);
+
+ int sizes[][2] = {{125, 117}, {245, 300}, {190, 146}, {200, 117}, {180, 111}, {20, 20}};
+ for (auto &size : sizes)
+ {
+  packer.Add(size[0], size[1]);
+ }
+
+ ASSERT_TRUE(packer.Pack());
+ ASSERT_LE(packer.GetWidth(), 300);
+
+ for (int i = 0; i < packer.GetCount(); i++)
+ {
+  auto &rect = packer.GetRect(i);
+  ASSERT_EQ(sizes[i][0], rect.width);
+  ASSERT_EQ(sizes[i][1], rect.height);
+  ASSERT_GE(rect.x, padding);
+  ASSERT_GE(rect.y, padding);
+  ASSERT_LE(rect.x + rect.width + padding, packer.GetWidth());
+  ASSERT_LE(rect.y + rect.height + padding, packer.GetHeight());
+
+  for (int j = 0; j < i; j++)
+  {
+   ASSERT_FALSE(Overlap(rect, packer.GetRect(j), padding)) << i << " overlaps " << j;
+  }
+ }
+}
+
+/**
+ * A rectangle wider than the atlas can't be packed.
+ */
+TEST(AtlasPackerTest, TooWide)
+{
+ AtlasPacker packer(100, 1);
+ packer.Add(50, 50);
+ packer.Add(99, 10);
+
+ ASSERT_FALSE(packer.Pack());
+}
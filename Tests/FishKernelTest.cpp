@@ -0,0 +1,121 @@
+/**
+ * @file FishKernelTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests and benchmark for the FishKernel class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <FishKernel.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/// Width of the tank the fish swim in
+const double TankWidth = 1024;
+
+/// Height of the tank the fish swim in
+const double TankHeight = 800;
+
+/**
+ * A set of fish arrays filled with random fish
+ */
+struct FishArrays {
+ vector<double> x, y, speedX, speedY, halfWidth, halfHeight;
+ vector<uint8_t> mirror;
+
+ /**
+  * Make random fish, some of them at or past the walls
+  * @param count Number of fish
+  * @param seed Random seed
+  */
+ FishArrays(size_t count, unsigned seed)
+ {
+  mt19937 random(seed);
+  uniform_real_distribution<double> across(-20, TankWidth + 20);
+  uniform_real_distribution<double> down(-20, TankHeight + 20);
+  uniform_real_distribution<double> speed(-100, 100);
+  uniform_int_distribution<int> size(20, 100);
+
+  for (size_t i = 0; i < count; i++)
+  {
+   x.push_back(across(random));
+   y.push_back(down(random));
+   speedX.push_back(i % 7 == 0 ? 0 : speed(random));
+   speedY.push_back(speed(random));
+   halfWidth.push_back(size(random) / 2.0);
+   halfHeight.push_back(size(random) / 2.0);
+   mirror.push_back(i % 2);
+  }
+ }
+
+ /**
+  * Pointers for a kernel to work on
+  * @return The batch
+  */
+ FishBatch Batch()
+ {
+  FishBatch batch;
+  batch.x = x.data();
+  batch.y = y.data();
+  batch.speedX = speedX.data();
+  batch.speedY = speedY.data();
+  batch.halfWidth = halfWidth.data();
+  batch.halfHeight = halfHeight.data();
+  batch.mirror = mirror.data();
+  batch.count = x.size();
+  return batch;
+ }
+
+ /**
+  * Compare every bit of two sets of fish
+  * @param other The other fish
+  * @return true if identical
+  */
+ bool Same(const FishArrays &other) const
+ {
+  auto same = [](const vector<double> &a, const vector<double> &b) {
+   return memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+  };
+
+  return same(x, other.x) && same(y, other.y) && same(speedX, other.speedX) &&
+   same(speedY, other.speedY) && mirror == other.mirror;
+ }
+};
+
+/**
+ * Every supported kernel gives exactly the scalar results,
+ * including counts that leave a partial group at the end.
+ */
+TEST(FishKernelTest, Match)
+{
+ const FishKernel::Level levels[] = {FishKernel::Level::SSE2, FishKernel::Level::AVX2};
+
+ for (size_t count : {0, 1, 3, 4, 5, 1001})
+ {
+  FishArrays expected(count, 42);
+  for (int frame = 0; frame < 100; frame++)
+  {
+   FishKernel::Move(FishKernel::Level::Scalar, expected.Batch(), 0.03, TankWidth, TankHeight);
+  }
+
+  for (auto level : levels)
+  {
+   if (!FishKernel::IsSupported(level))
+   {
+    continue;
+   }
+
+   FishArrays actual(count, 42);
+   for (int frame = 0; frame < 100; frame++)
+   {
+    FishKernel::Move(level, actual.Batch(), 0.03, TankWidth, TankHeight);
+   }
+
+   ASSERT_TRUE(expected.Same(actual)) << FishKernel::GetName(level) << " with " << count << " fish";
+  }
+ }
+}
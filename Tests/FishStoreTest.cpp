@@ -0,0 +1,259 @@
+/**
+ * @file FishStoreTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the FishStore class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <FishStore.h>
+#include <WorkerPool.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <FishNemo.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Fish move with their speed and turn around at the walls,
+ * mirroring when they turn to face left.
+ */
+TEST(FishStoreTest, Bounce)
+{
+ FishStore store;
+
+ auto slot = store.Add(50, 40);
+ store.SetLocation(slot, 500, 300);
+ store.SetSpeed(slot, 100, 0);
+
+ store.Update(0.5, 1000, 800);
+ ASSERT_NEAR(550, store.GetX(slot), 0.0001);
+ ASSERT_NEAR(300, store.GetY(slot), 0.0001);
+ ASSERT_FALSE(store.GetMirror(slot));
+
+ // Reaching the right wall less half the width turns the fish around
+ store.SetLocation(slot, 940, 300);
+ store.Update(0.1, 1000, 800);
+ ASSERT_NEAR(-100, store.GetSpeedX(slot), 0.0001);
+ ASSERT_TRUE(store.GetMirror(slot));
+
+ // And the left wall turns it back
+ store.SetLocation(slot, 60, 300);
+ store.Update(0.1, 1000, 800);
+ ASSERT_NEAR(100, store.GetSpeedX(slot), 0.0001);
+ ASSERT_FALSE(store.GetMirror(slot));
+
+ // Vertical speed reverses near the top and bottom
+ store.SetLocation(slot, 500, 45);
+ store.SetSpeed(slot, 0, -20);
+ store.Update(0.1, 1000, 800);
+ ASSERT_NEAR(20, store.GetSpeedY(slot), 0.0001);
+}
+
+/**
+ * Removing a fish moves the last one into its slot, and the
+ * fish viewing that slot follows it.
+ */
+TEST(FishStoreTest, Remove)
+{
+ Aquarium aquarium;
+ auto &store = aquarium.GetFishStore();
+
+ auto fish1 = make_shared<FishBeta>(&aquarium);
+ auto fish2 = make_shared<FishNemo>(&aquarium);
+ auto fish3 = make_shared<FishBeta>(&aquarium);
+ ASSERT_EQ(3u, store.GetCount());
+
+ fish1->SetLocation(100, 200);
+ fish2->SetLocation(300, 400);
+ fish3->SetLocation(500, 600);
+ fish3->SetMirror(true);
+
+ fish1 = nullptr;
+ ASSERT_EQ(2u, store.GetCount());
+
+ ASSERT_NEAR(300, fish2->GetX(), 0.0001);
+ ASSERT_NEAR(400, fish2->GetY(), 0.0001);
+ ASSERT_NEAR(500, fish3->GetX(), 0.0001);
+ ASSERT_NEAR(600, fish3->GetY(), 0.0001);
+ ASSERT_TRUE(fish3->GetMirror());
+ ASSERT_FALSE(fish2->GetMirror());
+
+ // The fish still hit test where they are
+ ASSERT_TRUE(fish3->HitTest(500, 600));
+
+ aquarium.Clear(L"");
+ fish2 = nullptr;
+ fish3 = nullptr;
+ ASSERT_EQ(0u, store.GetCount());
+}
+
+/**
+ * Fish are drawn between where they were before the last
+ * update and where they are now.
+ */
+TEST(FishStoreTest, Interpolation)
+{
+ FishStore store;
+ auto slot = store.Add(10, 10);
+ store.SetLocation(slot, 100, 200);
+ store.SetSpeed(slot, 60, -30);
+ store.Update(0.5, 1000, 1000);
+
+ ASSERT_NEAR(130, store.GetX(slot), 0.0001);
+ ASSERT_NEAR(185, store.GetY(slot), 0.0001);
+
+ store.SetInterpolation(0.25);
+ ASSERT_NEAR(107.5, store.GetDrawX(slot), 0.0001);
+ ASSERT_NEAR(196.25, store.GetDrawY(slot), 0.0001);
+
+ store.SetInterpolation(1);
+ ASSERT_NEAR(130, store.GetDrawX(slot), 0.0001);
+
+ // Moving a fish by hand puts it there at once
+ store.SetInterpolation(0);
+ store.SetLocation(slot, 500, 500);
+ ASSERT_NEAR(500, store.GetDrawX(slot), 0.0001);
+ ASSERT_NEAR(500, store.GetDrawY(slot), 0.0001);
+}
+
+/**
+ * Each fish changes its vertical speed once a second on its own
+ * timer, by an amount drawn from its own random stream.
+ */
+TEST(FishStoreTest, Jitter)
+{
+ const int count = 1000;
+
+ auto run = [count](FishStore &store, double elapsed, int frames) {
+  store.SetSeed(11);
+  for (int i = 0; i < count; i++)
+  {
+   auto slot = store.Add(10, 10);
+   store.SetLocation(slot, 500, 400);
+  }
+
+  for (int frame = 0; frame < frames; frame++)
+  {
+   store.Update(elapsed, 1000000, 1000000);
+  }
+ };
+
+ // Nothing changes before a second has passed
+ FishStore early;
+ run(early, 0.25, 4);
+ for (int i = 0; i < count; i++)
+ {
+  ASSERT_EQ(0, early.GetSpeedY(i));
+ }
+
+ // Then every fish gets exactly one change
+ FishStore store;
+ run(store, 0.25, 5);
+ int up = 0;
+ for (int i = 0; i < count; i++)
+ {
+  auto speed = store.GetSpeedY(i);
+  ASSERT_TRUE(speed == 5 || speed == -5);
+  up += speed > 0 ? 1 : 0;
+ }
+
+ // The streams differ between fish
+ ASSERT_GT(up, count / 4);
+ ASSERT_LT(up, count * 3 / 4);
+
+ // And the same seed gives the same changes
+ FishStore again;
+ run(again, 0.25, 5);
+ for (int i = 0; i < count; i++)
+ {
+  ASSERT_EQ(store.GetSpeedY(i), again.GetSpeedY(i));
+ }
+}
+
+/**
+ * The fish end up in exactly the same place whatever
+ * number of threads moves them.
+ */
+TEST(FishStoreTest, Threads)
+{
+ const int count = 200000;
+
+ auto populate = [count](FishStore &store) {
+  mt19937 random(5);
+  uniform_real_distribution<double> x(0, 1024);
+  uniform_real_distribution<double> y(0, 800);
+  uniform_real_distribution<double> speed(-100, 100);
+  for (int i = 0; i < count; i++)
+  {
+   auto slot = store.Add(60, 55);
+   store.SetLocation(slot, x(random), y(random));
+   store.SetSpeed(slot, speed(random), speed(random));
+  }
+ };
+
+ auto run = [&](WorkerPool &pool, FishStore &store) {
+  store.SetWorkerPool(&pool);
+  populate(store);
+  for (int frame = 0; frame < 50; frame++)
+  {
+   store.Update(0.03, 1024, 800);
+  }
+ };
+
+ WorkerPool single(1);
+ FishStore expected;
+ run(single, expected);
+
+ for (int threads : {2, 3, 8})
+ {
+  WorkerPool pool(threads);
+  FishStore actual;
+  run(pool, actual);
+
+  for (int i = 0; i < count; i++)
+  {
+   ASSERT_EQ(expected.GetX(i), actual.GetX(i)) << threads << " threads";
+   ASSERT_EQ(expected.GetY(i), actual.GetY(i)) << threads << " threads";
+   ASSERT_EQ(expected.GetSpeedX(i), actual.GetSpeedX(i)) << threads << " threads";
+   ASSERT_EQ(expected.GetSpeedY(i), actual.GetSpeedY(i)) << threads << " threads";
+   ASSERT_EQ(expected.GetMirror(i), actual.GetMirror(i)) << threads << " threads";
+  }
+ }
+}
+
+/**
+ * A crowd of fish stays in the tank (Tools/Benchmark times a million).
+ */
+TEST(FishStoreTest, Crowd)
+{
+ const int count = 10000;
+ const int frames = 10;
+
+ FishStore store;
+ store.Reserve(count);
+ mt19937 random(1);
+ uniform_real_distribution<double> x(100, 900);
+ uniform_real_distribution<double> y(100, 700);
+ uniform_real_distribution<double> speed(-100, 100);
+ for (int i = 0; i < count; i++)
+ {
+  auto slot = store.Add(60, 55);
+  store.SetLocation(slot, x(random), y(random));
+  store.SetSpeed(slot, speed(random), speed(random));
+ }
+
+ for (int f = 0; f < frames; f++)
+ {
+  store.Update(0.03, 1024, 800);
+ }
+
+ // Everything stays in the tank, give or take one step past a wall
+ for (int i = 0; i < count; i++)
+ {
+  ASSERT_GT(store.GetX(i), -10);
+  ASSERT_LT(store.GetX(i), 1034);
+ }
+}
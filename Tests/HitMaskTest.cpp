@@ -0,0 +1,76 @@
+/**
+ * @file HitMaskTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the HitMask class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <HitMask.h>
+#include <vector>
+
+/**
+ * Build a mask from an alpha channel and test pixels in and
+ * out of the opaque area, including across a word boundary.
+ */
+TEST(HitMaskTest, FromAlpha)
+{
+ const int wid = 100;
+ const int hit = 10;
+ std::vector<unsigned char> alpha(wid * hit, 0);
+
+ // Opaque block from (60, 2) to (70, 5)
+ for (int y = 2; y <= 5; y++)
+ {
+  for (int x = 60; x <= 70; x++)
+  {
+   alpha[y * wid + x] = 255;
+  }
+ }
+
+ // A nearly transparent pixel below the threshold
+ alpha[8 * wid + 10] = 100;
+
+ auto mask = HitMask::FromAlpha(wid, hit, alpha.data(), 128);
+
+ ASSERT_FALSE(mask.IsEmpty());
+ ASSERT_EQ(60, mask.GetLeft());
+ ASSERT_EQ(70, mask.GetRight());
+ ASSERT_EQ(2, mask.GetTop());
+ ASSERT_EQ(5, mask.GetBottom());
+
+ ASSERT_TRUE(mask.Test(60, 2));
+ ASSERT_TRUE(mask.Test(63, 3));
+ ASSERT_TRUE(mask.Test(64, 3));
+ ASSERT_TRUE(mask.Test(70, 5));
+ ASSERT_FALSE(mask.Test(59, 3));
+ ASSERT_FALSE(mask.Test(71, 3));
+ ASSERT_FALSE(mask.Test(10, 8));
+
+ // Outside the mask entirely
+ ASSERT_FALSE(mask.Test(-1, 3));
+ ASSERT_FALSE(mask.Test(65, 200));
+}
+
+/**
+ * Mirroring flips the bits and the bounding box left to right.
+ */
+TEST(HitMaskTest, Mirror)
+{
+ HitMask mask(10, 4);
+ ASSERT_TRUE(mask.IsEmpty());
+ ASSERT_FALSE(mask.Test(0, 0));
+
+ mask.Set(1, 2);
+ mask.Set(3, 1);
+
+ auto mirror = mask.Mirror();
+ ASSERT_TRUE(mirror.Test(8, 2));
+ ASSERT_TRUE(mirror.Test(6, 1));
+ ASSERT_FALSE(mirror.Test(1, 2));
+ ASSERT_EQ(6, mirror.GetLeft());
+ ASSERT_EQ(8, mirror.GetRight());
+ ASSERT_EQ(1, mirror.GetTop());
+ ASSERT_EQ(2, mirror.GetBottom());
+}
@@ -0,0 +1,98 @@
+/**
+ * @file ItemArenaTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the ItemArena class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <ItemArena.h>
+#include <Aquarium.h>
+#include <DecorCastle.h>
+#include <set>
+
+using namespace std;
+
+/**
+ * Freed slots are reused, blocks grow, and nothing is
+ * released while a slot is in use.
+ */
+TEST(ItemArenaTest, Pool)
+{
+ ItemPool pool(40, 8);
+
+ auto a = pool.Allocate();
+ auto b = pool.Allocate();
+ ASSERT_NE(a, b);
+ ASSERT_EQ(0u, (uintptr_t)a % 8);
+ ASSERT_EQ(2u, pool.GetLive());
+ ASSERT_EQ(1u, pool.GetBlockCount());
+
+ pool.Deallocate(a);
+ ASSERT_EQ(a, pool.Allocate());
+
+ // Two hundred thousand slots take a handful of blocks, all distinct
+ set<void *> slots{a, b};
+ for (int i = 0; i < 200000; i++)
+ {
+  ASSERT_TRUE(slots.insert(pool.Allocate()).second);
+ }
+ ASSERT_LE(pool.GetBlockCount(), 13u);
+
+ ASSERT_FALSE(pool.Release());
+ for (auto slot : slots)
+ {
+  pool.Deallocate(slot);
+ }
+ ASSERT_TRUE(pool.Release());
+ ASSERT_EQ(0u, pool.GetBlockCount());
+}
+
+/**
+ * The aquarium makes its items in the arena and hands
+ * the memory back when cleared.
+ */
+TEST(ItemArenaTest, Aquarium)
+{
+ Aquarium aquarium;
+ auto &arena = aquarium.GetArena();
+
+ for (int i = 0; i < 100; i++)
+ {
+  aquarium.Add(aquarium.Create(L"beta"));
+  aquarium.Add(aquarium.Create(L"castle"));
+ }
+ ASSERT_EQ(200u, arena.GetLive());
+ ASSERT_GE(arena.GetBlockCount(), 2u);
+
+ aquarium.Clear(L"");
+ ASSERT_EQ(0u, arena.GetLive());
+ ASSERT_EQ(0u, arena.GetBlockCount());
+
+ // An item still held elsewhere keeps its pool
+ auto castle = aquarium.Create(L"castle");
+ aquarium.Add(castle);
+ aquarium.Add(aquarium.Create(L"nemo"));
+ aquarium.Clear(L"");
+ ASSERT_EQ(1u, arena.GetLive());
+ ASSERT_EQ(1u, arena.GetBlockCount());
+
+ castle = nullptr;
+ ASSERT_EQ(0u, arena.GetLive());
+}
+
+/**
+ * An item can outlive the aquarium that made it.
+ */
+TEST(ItemArenaTest, OutliveAquarium)
+{
+ shared_ptr<Item> castle;
+ {
+  Aquarium aquarium;
+  castle = aquarium.Create(L"castle");
+ }
+
+ ASSERT_TRUE(castle->IsStatic());
+ castle = nullptr;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file ItemHandleTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for finding, reordering and removing items by handle.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Aquarium.h>
+#include <DecorCastle.h>
+#include <FishBeta.h>
+
+using namespace std;
+
+/**
+ * Handles find their item until it is removed, and never
+ * find the item that reuses the slot.
+ */
+TEST(ItemHandleTest, Stale)
+{
+ Aquarium aquarium;
+ ItemHandle none;
+ ASSERT_TRUE(none.IsNull());
+ ASSERT_EQ(nullptr, aquarium.Find(none));
+
+ auto castle = make_shared<DecorCastle>(&aquarium);
+ ASSERT_TRUE(castle->GetHandle().IsNull());
+
+ aquarium.Add(castle);
+ auto handle = castle->GetHandle();
+ ASSERT_FALSE(handle.IsNull());
+ ASSERT_EQ(castle.get(), aquarium.Find(handle));
+
+ aquarium.Remove(handle);
+ ASSERT_EQ(nullptr, aquarium.Find(handle));
+ ASSERT_TRUE(castle->GetHandle().IsNull());
+ ASSERT_TRUE(aquarium.GetFishes().empty());
+
+ // The slot is reused with a new generation
+ auto beta = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(beta);
+ ASSERT_EQ(handle.index, beta->GetHandle().index);
+ ASSERT_NE(handle, beta->GetHandle());
+ ASSERT_EQ(nullptr, aquarium.Find(handle));
+
+ // Removing or moving by a stale handle does nothing
+ aquarium.Remove(handle);
+ aquarium.MoveToFront(handle);
+ ASSERT_EQ(1u, aquarium.GetFishes().size());
+
+ // Clearing stales every handle
+ auto betaHandle = beta->GetHandle();
+ aquarium.Clear(L"");
+ ASSERT_EQ(nullptr, aquarium.Find(betaHandle));
+}
+
+/**
+ * Moving to the front and removing keep the order of the rest.
+ */
+TEST(ItemHandleTest, Order)
+{
+ Aquarium aquarium;
+ vector<ItemHandle> handles;
+ for (int i = 0; i < 5; i++)
+ {
+  auto castle = make_shared<DecorCastle>(&aquarium);
+  aquarium.Add(castle);
+  handles.push_back(castle->GetHandle());
+ }
+
+ aquarium.MoveToFront(handles[1]);
+ aquarium.Remove(handles[3]);
+ aquarium.MoveToFront(handles[0]);
+
+ vector<ItemHandle> expected = {handles[2], handles[4], handles[1], handles[0]};
+
+ // Readers see the same order through the holes, without compacting
+ const Aquarium &reader = aquarium;
+ vector<ItemHandle> visited;
+ reader.ForEachItem([&visited](const Item &item) { visited.push_back(item.GetHandle()); });
+ ASSERT_EQ(expected.size(), reader.GetItemCount());
+ ASSERT_TRUE(expected == visited);
+ ASSERT_EQ(handles[0], reader.HitTest(200, 200));
+
+ auto &items = aquarium.GetFishes();
+ ASSERT_EQ(expected.size(), items.size());
+ for (size_t i = 0; i < expected.size(); i++)
+ {
+  ASSERT_EQ(expected[i], items[i]->GetHandle());
+  ASSERT_EQ(items[i].get(), aquarium.Find(expected[i]));
+ }
+
+ // Hit testing sees the new order too
+ ASSERT_EQ(handles[0], aquarium.HitTest(200, 200));
+}
+
+/**
+ * Bringing many items to the front keeps every item, in
+ * the right order (Tools/Benchmark times it).
+ */
+TEST(ItemHandleTest, ManyItems)
+{
+ const int count = 10000;
+
+ Aquarium aquarium;
+ vector<ItemHandle> handles;
+ for (int i = 0; i < count; i++)
+ {
+  auto item = aquarium.Create(L"castle");
+  aquarium.Add(item);
+  handles.push_back(item->GetHandle());
+ }
+
+ for (int i = 0; i < count; i++)
+ {
+  aquarium.MoveToFront(handles[(i * 7919) % count]);
+ }
+
+ ASSERT_EQ((size_t)count, aquarium.GetFishes().size());
+ ASSERT_EQ(handles[((count - 1) * 7919) % count], aquarium.GetFishes().back()->GetHandle());
+}
@@ -98,3 +98,31 @@ ItemMock fish(&aquarium);
  // Test a transparent pixel location on the fish (adjust values based on actual bitmap size)
  ASSERT_FALSE(fish.HitTest(100 - 125 / 2 + 17, 200 - 117 / 2 + 16));
 }
+
+/**
+ * Test that HitTest follows the mirrored orientation of the item.
+ */
+TEST(ItemTest, HitTestMirror)
+{
+ Aquarium aquarium;
+ ItemMock fish(&aquarium);
+ fish.SetLocation(100, 200);
+
+ // Pixel (21, 35) of beta.png is opaque and its mirror image
+ // (125 - 1 - 21, 35) is transparent
+ int left = 100 - 125 / 2 + 21;
+ int right = 100 - 125 / 2 + (125 - 1 - 21);
+ int y = 200 - 117 / 2 + 35;
+ ASSERT_TRUE(fish.HitTest(left, y));
+ ASSERT_FALSE(fish.HitTest(right, y));
+
+ // Mirroring swaps which side is drawn
+ fish.SetMirror(true);
+ ASSERT_TRUE(fish.GetMirror());
+ ASSERT_FALSE(fish.HitTest(left, y));
+ ASSERT_TRUE(fish.HitTest(right, y));
+
+ fish.SetMirror(false);
+ ASSERT_TRUE(fish.HitTest(left, y));
+ ASSERT_FALSE(fish.HitTest(right, y));
+}
@@ -0,0 +1,273 @@
+/**
+ * @file ItemWorldTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the ItemWorld class and its systems.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <ItemWorld.h>
+#include <ItemSystem.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <DecorCastle.h>
+#include <atomic>
+#include <random>
+
+using namespace std;
+
+/// A component with no arrays, marking fish that glow
+const ComponentMask Glow = 1 << 16;
+
+/**
+ * System that counts the rows it is run on
+ */
+class GlowSystem : public ItemSystem {
+public:
+ /// Rows run on so far
+ atomic<size_t> mRows{0};
+
+ /**
+  * The components an entity needs to glow
+  * @return Glow
+  */
+ ComponentMask GetComponents() const override { return Glow; }
+
+ /**
+  * Count some rows
+  * @param table Table of glowing entities
+  * @param begin First row
+  * @param end One past the last row
+  * @param elapsed Time since the last update
+  * @param width Width of the aquarium
+  * @param height Height of the aquarium
+  */
+ void Run(ItemTable &table, size_t begin, size_t end, double elapsed, double width, double height) override
+ {
+  mRows += end - begin;
+ }
+};
+
+/**
+ * Entities keep their components while others come and go,
+ * and destroyed ones are reused.
+ */
+TEST(ItemWorldTest, CreateDestroy)
+{
+ ItemWorld world;
+ auto a = world.Create(Component::Fish);
+ auto b = world.Create(Component::Fish);
+ auto c = world.Create(Component::Item);
+ world.SetLocation(a, 1, 2);
+ world.SetLocation(b, 3, 4);
+ world.SetLocation(c, 5, 6);
+ ASSERT_EQ(2u, world.GetCount(Component::Velocity));
+ ASSERT_EQ(3u, world.GetCount(Component::Transform));
+
+ world.Destroy(a);
+ ASSERT_EQ(1u, world.GetCount(Component::Velocity));
+ ASSERT_NEAR(3, world.GetX(b), 0.0001);
+ ASSERT_NEAR(6, world.GetY(c), 0.0001);
+ ASSERT_FALSE(world.Has(c, Component::Velocity));
+
+ auto d = world.Create(Component::Item);
+ ASSERT_EQ(a, d);
+ ASSERT_NEAR(0, world.GetX(d), 0.0001);
+}
+
+/**
+ * Adding and removing components moves an entity between
+ * tables without losing the components it keeps.
+ */
+TEST(ItemWorldTest, AddRemoveComponents)
+{
+ ItemWorld world;
+ auto a = world.Create(Component::Item);
+ auto b = world.Create(Component::Item);
+ world.SetLocation(a, 100, 200);
+ world.SetMirror(a, true);
+ world.SetType(a, L"castle");
+ world.SetLocation(b, 300, 400);
+
+ world.AddComponents(a, Component::Velocity);
+ ASSERT_TRUE(world.Has(a, Component::Velocity));
+ ASSERT_NEAR(100, world.GetX(a), 0.0001);
+ ASSERT_TRUE(world.GetMirror(a));
+ ASSERT_EQ(wstring(L"castle"), world.GetType(a));
+ ASSERT_EQ(0, world.GetSpeedX(a));
+
+ // The entity moved into the hole is still found
+ ASSERT_NEAR(300, world.GetX(b), 0.0001);
+
+ world.RemoveComponents(a, Component::Velocity | Component::Persist);
+ ASSERT_FALSE(world.Has(a, Component::Velocity));
+ ASSERT_FALSE(world.Has(a, Component::Persist));
+ ASSERT_NEAR(200, world.GetY(a), 0.0001);
+}
+
+/**
+ * Systems only run on the entities that have their components,
+ * and decor is never moved.
+ */
+TEST(ItemWorldTest, OnlyMatchingEntities)
+{
+ ItemWorld world;
+ auto glow = make_unique<GlowSystem>();
+ auto &counter = *glow;
+ world.AddSystem(std::move(glow));
+
+ for (int i = 0; i < 1000; i++)
+ {
+  auto fish = world.Create(i % 4 == 0 ? Component::Fish | Glow : Component::Fish);
+  world.SetLocation(fish, 500, 400);
+  world.SetSpeed(fish, 10, 0);
+ }
+
+ auto decor = world.Create(Component::Item);
+ world.SetLocation(decor, 100, 100);
+
+ world.Update(0.5, 1000, 800);
+ ASSERT_EQ(250u, counter.mRows.load());
+ ASSERT_NEAR(505, world.GetX(0), 0.0001);
+ ASSERT_NEAR(505, world.GetX(1), 0.0001);
+ ASSERT_NEAR(100, world.GetX(decor), 0.0001);
+}
+
+/**
+ * Fish in different tables school together just as if they
+ * were all in one.
+ */
+TEST(ItemWorldTest, SchoolAcrossTables)
+{
+ auto run = [](bool split, vector<double> &x, vector<double> &y) {
+  ItemWorld world;
+  world.GetSchooling().SetEnabled(true);
+  world.GetSchooling().SetMaxNeighbors(1000);
+
+  mt19937 random(3);
+  uniform_real_distribution<double> location(400, 500);
+  uniform_real_distribution<double> speed(-50, 50);
+  for (int i = 0; i < 200; i++)
+  {
+   auto fish = world.Create(split && i % 2 == 0 ? Component::Fish | Glow : Component::Fish);
+   world.SetHalfSize(fish, 10, 10);
+   world.SetSpecies(fish, FishSpecies::Nemo);
+   world.SetLocation(fish, location(random), location(random));
+   world.SetSpeed(fish, speed(random), speed(random));
+  }
+
+  for (int step = 0; step < 20; step++)
+  {
+   world.Update(1.0 / 60, 1000, 800);
+  }
+
+  for (Entity fish = 0; fish < 200; fish++)
+  {
+   x.push_back(world.GetX(fish));
+   y.push_back(world.GetY(fish));
+  }
+ };
+
+ vector<double> x1, y1, x2, y2;
+ run(false, x1, y1);
+ run(true, x2, y2);
+ for (size_t i = 0; i < x1.size(); i++)
+ {
+  ASSERT_NEAR(x1[i], x2[i], 0.0001);
+  ASSERT_NEAR(y1[i], y2[i], 0.0001);
+ }
+}
+
+/**
+ * Items are views over their entity in the aquarium's world.
+ */
+TEST(ItemWorldTest, ItemFacade)
+{
+ Aquarium aquarium;
+ auto &world = *aquarium.GetWorld();
+
+ auto castle = make_shared<DecorCastle>(&aquarium);
+ auto beta = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(castle);
+ aquarium.Add(beta);
+ castle->SetLocation(100, 200);
+ beta->SetLocation(300, 400);
+
+ ASSERT_EQ(2u, world.GetCount(Component::Item));
+ ASSERT_EQ(1u, world.GetCount(Component::Velocity));
+ ASSERT_EQ(1u, aquarium.GetFishStore().GetCount());
+
+ beta->SetSpeed(30, 0);
+ aquarium.Update(1);
+ ASSERT_NEAR(330, beta->GetX(), 0.0001);
+ ASSERT_NEAR(100, castle->GetX(), 0.0001);
+
+ aquarium.Clear(L"");
+ castle = nullptr;
+ beta = nullptr;
+ ASSERT_EQ(0u, world.GetCount(Component::Transform));
+}
+
+/**
+ * Running a batch of steps gives the same result as running them
+ * one at a time, with schooling on or off.
+ */
+TEST(ItemWorldTest, BatchedSteps)
+{
+ auto run = [](bool schooling, int batch, vector<double> &x, vector<double> &y) {
+  ItemWorld world;
+  world.SetSeed(5);
+  world.GetSchooling().SetEnabled(schooling);
+
+  mt19937 random(7);
+  uniform_real_distribution<double> location(100, 900);
+  uniform_real_distribution<double> speed(-80, 80);
+  for (int i = 0; i < 500; i++)
+  {
+   auto fish = world.Create(Component::Fish);
+   world.SetHalfSize(fish, 10, 10);
+   world.SetSpecies(fish, FishSpecies::Dory);
+   world.SetLocation(fish, location(random), location(random) * 0.8);
+   world.SetSpeed(fish, speed(random), speed(random));
+  }
+
+  for (int step = 0; step < 120; step += batch)
+  {
+   world.Update(1.0 / 60, 1000, 800, batch);
+  }
+
+  for (Entity fish = 0; fish < 500; fish++)
+  {
+   x.push_back(world.GetX(fish));
+   y.push_back(world.GetY(fish));
+  }
+ };
+
+ for (bool schooling : {false, true})
+ {
+  vector<double> x1, y1, x2, y2;
+  run(schooling, 1, x1, y1);
+  run(schooling, 40, x2, y2);
+  ASSERT_EQ(x1, x2);
+  ASSERT_EQ(y1, y2);
+ }
+}
+
+/**
+ * Chunks shrink so every thread gets several, down to a minimum
+ */
+TEST(ItemWorldTest, ChunkSize)
+{
+ // 100,000 fish on 16 threads is four chunks or more a thread
+ auto chunk = ItemSystem::GetChunk(100000, 16);
+ ASSERT_GE((100000 + chunk - 1) / chunk, 16u * ItemSystem::ChunksPerThread);
+ ASSERT_EQ(0u, chunk % ItemSystem::MinChunk);
+
+ // Never smaller than the minimum
+ ASSERT_EQ(ItemSystem::MinChunk, ItemSystem::GetChunk(100, 16));
+ ASSERT_EQ(ItemSystem::MinChunk, ItemSystem::GetChunk(0, 1));
+
+ // One thread gets a few big ones
+ ASSERT_EQ(24576u, ItemSystem::GetChunk(100000, 1));
+}
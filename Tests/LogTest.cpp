@@ -0,0 +1,183 @@
+/**
+ * @file LogTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the Log class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Log.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Points the log at a string for a test and puts it back after
+ */
+class LogTest : public ::testing::Test {
+protected:
+ /// Everything the log handed over
+ string mText;
+
+ /// Number of times the log handed text over
+ int mWrites = 0;
+
+ void SetUp() override
+ {
+  Log::Instance().SetSink([this](const string &text) {
+   mText += text;
+   mWrites++;
+  });
+ }
+
+ void TearDown() override
+ {
+  Log::Instance().SetLevel(Log::Level::Off);
+  Log::Instance().SetSink(nullptr);
+ }
+};
+
+/**
+ * The log is off unless turned on, and nothing is formatted while it is
+ */
+TEST_F(LogTest, OffByDefault)
+{
+ ASSERT_EQ(Log::Level::Off, Log::Instance().GetLevel());
+
+ int formatted = 0;
+ auto count = [&formatted]() { return ++formatted; };
+ AQUARIUM_LOG(Log::Level::Error, "Formatted " << count());
+ Log::Instance().Flush();
+
+ ASSERT_EQ(0, formatted);
+ ASSERT_EQ("", mText);
+}
+
+/**
+ * Only messages at the level or above get through
+ */
+TEST_F(LogTest, Levels)
+{
+ Log::Instance().SetLevel(Log::Level::Warning);
+ AQUARIUM_LOG(Log::Level::Debug, "debug " << 1);
+ AQUARIUM_LOG(Log::Level::Info, "info " << 2);
+ AQUARIUM_LOG(Log::Level::Warning, "warning " << 3);
+ AQUARIUM_LOG(Log::Level::Error, "error " << 4);
+ Log::Instance().Flush();
+
+ ASSERT_EQ("[warning] warning 3\n[error] error 4\n", mText);
+}
+
+/**
+ * Debug statements are only there in builds that compile them in
+ */
+TEST_F(LogTest, CompiledLevel)
+{
+ Log::Instance().SetLevel(Log::Level::Debug);
+
+ int formatted = 0;
+ auto count = [&formatted]() { return ++formatted; };
+ AQUARIUM_LOG(Log::Level::Debug, "Formatted " << count());
+ Log::Instance().Flush();
+
+ if (Log::CompiledLevel > Log::Level::Debug)
+ {
+  ASSERT_EQ(0, formatted);
+  ASSERT_EQ("", mText);
+ }
+ else
+ {
+  ASSERT_EQ(1, formatted);
+  ASSERT_EQ("[debug] Formatted 1\n", mText);
+ }
+}
+
+/**
+ * Threads log at once, and each thread's messages stay in order
+ */
+TEST_F(LogTest, Threads)
+{
+ const int Threads = 4;
+ const int Messages = 1000;
+ Log::Instance().SetLevel(Log::Level::Info);
+
+ vector<thread> threads;
+ for (int t = 0; t < Threads; t++)
+ {
+  threads.emplace_back([t]() {
+   for (int i = 0; i < Messages; i++)
+   {
+    AQUARIUM_LOG(Log::Level::Info, t << " " << i);
+   }
+  });
+ }
+
+ for (auto &thread : threads)
+ {
+  thread.join();
+ }
+ Log::Instance().Flush();
+
+ vector<int> next(Threads, 0);
+ istringstream lines(mText);
+ string tag;
+ int t, i, total = 0;
+ while (lines >> tag >> t >> i)
+ {
+  ASSERT_EQ("[info]", tag);
+  ASSERT_EQ(next[t], i);
+  next[t]++;
+  total++;
+ }
+
+ ASSERT_EQ(Threads * Messages, total);
+}
+
+/**
+ * Writing to a full ring drops the message rather than waiting,
+ * and the drops are reported
+ */
+TEST_F(LogTest, Full)
+{
+ const size_t Messages = Log::Capacity * 3;
+ Log::Instance().SetLevel(Log::Level::Info);
+ auto dropped = Log::Instance().GetDropped();
+
+ for (size_t i = 0; i < Messages; i++)
+ {
+  AQUARIUM_LOG(Log::Level::Info, "Message " << i);
+ }
+ Log::Instance().Flush();
+
+ size_t logged = 0;
+ for (auto at = mText.find("[info] "); at != string::npos; at = mText.find("[info] ", at + 1))
+ {
+  logged++;
+ }
+
+ // Drops may be reported in pieces, if the ring was emptied in between
+ size_t reported = 0;
+ for (auto at = mText.find("[warning] "); at != string::npos; at = mText.find("[warning] ", at + 1))
+ {
+  reported += stoul(mText.substr(at + 10));
+ }
+
+ dropped = Log::Instance().GetDropped() - dropped;
+ ASSERT_EQ(Messages, logged + dropped);
+ ASSERT_EQ(dropped, reported);
+}
+
+/**
+ * Messages too long for an entry are cut short
+ */
+TEST_F(LogTest, Long)
+{
+ Log::Instance().SetLevel(Log::Level::Info);
+ AQUARIUM_LOG(Log::Level::Info, string(Log::MessageSize * 2, 'x'));
+ Log::Instance().Flush();
+
+ ASSERT_EQ("[info] " + string(Log::MessageSize, 'x') + "\n", mText);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file PerfectHashTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the PerfectHash class template.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <PerfectHash.h>
+#include <string>
+
+using namespace std;
+
+/// Names hashed by the compiler
+constexpr PerfectHash<5> Names{{{L"beta", L"nemo", L"dory", L"castle", L"angel"}}};
+
+static_assert(Names.IsPerfect(), "No collisions");
+static_assert(Names.Find(L"dory") == 2, "Found at compile time");
+
+/**
+ * Every name finds its own index and nothing else finds anything
+ */
+TEST(PerfectHashTest, Find)
+{
+ ASSERT_EQ(0, Names.Find(L"beta"));
+ ASSERT_EQ(1, Names.Find(L"nemo"));
+ ASSERT_EQ(2, Names.Find(L"dory"));
+ ASSERT_EQ(3, Names.Find(L"castle"));
+ ASSERT_EQ(4, Names.Find(L"angel"));
+
+ ASSERT_EQ(-1, Names.Find(L""));
+ ASSERT_EQ(-1, Names.Find(L"bet"));
+ ASSERT_EQ(-1, Names.Find(L"betas"));
+ ASSERT_EQ(-1, Names.Find(L"Beta"));
+}
+
+/**
+ * A larger set, built at run time, is still perfect
+ */
+TEST(PerfectHashTest, ManyNames)
+{
+ vector<wstring> strings;
+ array<const wchar_t *, 100> names;
+ for (size_t i = 0; i < names.size(); i++)
+ {
+  strings.push_back(L"species" + to_wstring(i));
+ }
+ for (size_t i = 0; i < names.size(); i++)
+ {
+  names[i] = strings[i].c_str();
+ }
+
+ PerfectHash<100> hash(names);
+ ASSERT_TRUE(hash.IsPerfect());
+ for (size_t i = 0; i < names.size(); i++)
+ {
+  ASSERT_EQ(int(i), hash.Find(names[i]));
+ }
+ ASSERT_EQ(-1, hash.Find(L"species100"));
+}
@@ -0,0 +1,158 @@
+/**
+ * @file PopulationGeneratorTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the PopulationGenerator class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <PopulationGenerator.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <FishNemo.h>
+#include <FishDory.h>
+#include <DecorCastle.h>
+
+using namespace std;
+
+/**
+ * The mix and decor density decide how many of each there are
+ */
+TEST(PopulationGeneratorTest, Mix)
+{
+ Aquarium aquarium;
+ PopulationGenerator generator(7);
+ generator.SetCount(20000);
+ generator.SetMix(L"beta", 2);
+ generator.SetMix(L"nemo", 1);
+ generator.SetMix(L"dory", 1);
+ generator.SetDecorDensity(0.01);
+
+ ASSERT_EQ(20000u, generator.Generate(aquarium));
+ ASSERT_EQ(20000u, aquarium.GetFishes().size());
+ ASSERT_EQ(19800u, aquarium.GetFishStore().GetCount());
+
+ size_t betas = 0, nemos = 0, dories = 0, castles = 0;
+ for (auto &item : aquarium.GetFishes())
+ {
+  betas += dynamic_pointer_cast<FishBeta>(item) != nullptr;
+  nemos += dynamic_pointer_cast<FishNemo>(item) != nullptr;
+  dories += dynamic_pointer_cast<FishDory>(item) != nullptr;
+  castles += dynamic_pointer_cast<DecorCastle>(item) != nullptr;
+ }
+
+ ASSERT_EQ(200u, castles);
+ ASSERT_NEAR(9900.0, betas, 300);
+ ASSERT_NEAR(4950.0, nemos, 300);
+ ASSERT_NEAR(4950.0, dories, 300);
+
+ // Decor is behind every fish
+ for (size_t i = 0; i < castles; i++)
+ {
+  ASSERT_NE(nullptr, dynamic_pointer_cast<DecorCastle>(aquarium.GetFishes()[i]));
+ }
+}
+
+/**
+ * Every layout keeps items in the tank, and every item can be found
+ */
+TEST(PopulationGeneratorTest, Layouts)
+{
+ for (auto layout : {PopulationGenerator::Layout::Uniform, PopulationGenerator::Layout::Schools,
+                     PopulationGenerator::Layout::Layers})
+ {
+  Aquarium aquarium;
+  PopulationGenerator generator(3);
+  generator.SetCount(5000);
+  generator.SetLayout(layout);
+  generator.SetSchools(4, 200);
+  generator.Generate(aquarium);
+
+  for (auto &item : aquarium.GetFishes())
+  {
+   ASSERT_GE(item->GetX(), 0);
+   ASSERT_LE(item->GetX(), aquarium.GetWidth());
+   ASSERT_GE(item->GetY(), 0);
+   ASSERT_LE(item->GetY(), aquarium.GetHeight());
+   ASSERT_EQ(item.get(), aquarium.Find(item->GetHandle()));
+  }
+ }
+}
+
+/**
+ * In layers, each species keeps to a band of its own
+ */
+TEST(PopulationGeneratorTest, Layers)
+{
+ Aquarium aquarium;
+ PopulationGenerator generator(5);
+ generator.SetCount(3000);
+ generator.SetLayout(PopulationGenerator::Layout::Layers);
+ generator.SetDecorDensity(0);
+ generator.Generate(aquarium);
+
+ double betaMax = 0, nemoMin = aquarium.GetHeight(), nemoMax = 0, doryMin = aquarium.GetHeight();
+ for (auto &item : aquarium.GetFishes())
+ {
+  if (dynamic_pointer_cast<FishBeta>(item) != nullptr)
+  {
+   betaMax = max(betaMax, item->GetY());
+  }
+  else if (dynamic_pointer_cast<FishNemo>(item) != nullptr)
+  {
+   nemoMin = min(nemoMin, item->GetY());
+   nemoMax = max(nemoMax, item->GetY());
+  }
+  else
+  {
+   doryMin = min(doryMin, item->GetY());
+  }
+ }
+
+ ASSERT_LE(betaMax, nemoMin);
+ ASSERT_LE(nemoMax, doryMin);
+}
+
+/**
+ * The same seed gives the same tank and another seed another one
+ */
+TEST(PopulationGeneratorTest, Seeded)
+{
+ auto positions = [](uint64_t seed) {
+  Aquarium aquarium;
+  PopulationGenerator generator(seed);
+  generator.SetCount(2000);
+  generator.SetLayout(PopulationGenerator::Layout::Schools);
+  generator.Generate(aquarium);
+
+  vector<double> result;
+  for (auto &item : aquarium.GetFishes())
+  {
+   result.push_back(item->GetX());
+   result.push_back(item->GetY());
+  }
+  return result;
+ };
+
+ ASSERT_EQ(positions(11), positions(11));
+ ASSERT_NE(positions(11), positions(12));
+}
+
+/**
+ * A generated population goes in front of what is there
+ */
+TEST(PopulationGeneratorTest, AddsInFront)
+{
+ Aquarium aquarium;
+ auto castle = aquarium.Create(L"castle");
+ aquarium.Add(castle);
+
+ PopulationGenerator generator(1);
+ generator.SetCount(100);
+ ASSERT_EQ(100u, generator.Generate(aquarium));
+
+ ASSERT_EQ(101u, aquarium.GetFishes().size());
+ ASSERT_EQ(castle, aquarium.GetFishes().front());
+ ASSERT_EQ(castle.get(), aquarium.Find(castle->GetHandle()));
+}
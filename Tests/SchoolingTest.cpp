@@ -0,0 +1,220 @@
+/**
+ * @file SchoolingTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the Schooling class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <FishStore.h>
+#include <WorkerPool.h>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+/**
+ * Add a fish to a store
+ * @param store Store to add to
+ * @param species Species of the fish
+ * @param x X location
+ * @param y Y location
+ * @param speedX X speed
+ * @param speedY Y speed
+ * @return Slot of the fish
+ */
+static int AddFish(FishStore &store, FishSpecies species, double x, double y, double speedX, double speedY)
+{
+ auto slot = store.Add(10, 10);
+ store.SetSpecies(slot, species);
+ store.SetLocation(slot, x, y);
+ store.SetSpeed(slot, speedX, speedY);
+ return slot;
+}
+
+/**
+ * Schooling is off until turned on.
+ */
+TEST(SchoolingTest, Off)
+{
+ FishStore store;
+ ASSERT_FALSE(store.GetSchooling().IsEnabled());
+
+ auto a = AddFish(store, FishSpecies::Nemo, 200, 200, 30, 0);
+ auto b = AddFish(store, FishSpecies::Nemo, 225, 200, 0, 30);
+ store.Update(0.1, 1000, 800);
+
+ ASSERT_EQ(30, store.GetSpeedX(a));
+ ASSERT_EQ(0, store.GetSpeedY(a));
+ ASSERT_EQ(0, store.GetSpeedX(b));
+ ASSERT_EQ(30, store.GetSpeedY(b));
+}
+
+/**
+ * Neighbors of one species turn to swim the same way and
+ * close up, and turn to face the way they swim.
+ */
+TEST(SchoolingTest, AlignmentAndCohesion)
+{
+ FishStore store;
+ store.GetSchooling().SetEnabled(true);
+
+ auto a = AddFish(store, FishSpecies::Nemo, 200, 200, 30, 0);
+ auto b = AddFish(store, FishSpecies::Nemo, 225, 200, -30, 10);
+
+ auto difference = [&]() {
+  return hypot(store.GetSpeedX(a) - store.GetSpeedX(b), store.GetSpeedY(a) - store.GetSpeedY(b));
+ };
+
+ auto before = difference();
+ for (int i = 0; i < 10; i++)
+ {
+  store.Update(0.05, 1000, 800);
+ }
+
+ ASSERT_LT(difference(), before);
+ ASSERT_LT(hypot(store.GetX(a) - store.GetX(b), store.GetY(a) - store.GetY(b)), 25);
+
+ // Speeds stay within the species limits
+ auto &rules = store.GetSchooling().GetRules(FishSpecies::Nemo);
+ for (auto slot : {a, b})
+ {
+  auto speed = hypot(store.GetSpeedX(slot), store.GetSpeedY(slot));
+  ASSERT_GE(speed, rules.minSpeed - 1e-9);
+  ASSERT_LE(speed, rules.maxSpeed + 1e-9);
+  ASSERT_EQ(store.GetSpeedX(slot) < 0, store.GetMirror(slot));
+ }
+}
+
+/**
+ * Fish too close push apart, whatever their species.
+ */
+TEST(SchoolingTest, Separation)
+{
+ FishStore store;
+ store.GetSchooling().SetEnabled(true);
+
+ auto a = AddFish(store, FishSpecies::Beta, 500, 400, 60, 0);
+ auto b = AddFish(store, FishSpecies::Dory, 505, 400, 150, 0);
+ store.Update(0.01, 1000, 800);
+
+ ASSERT_LT(store.GetSpeedX(a), 60);
+ ASSERT_GT(store.GetSpeedX(b), 150);
+}
+
+/**
+ * Fish of different species, or too far apart, do not school.
+ */
+TEST(SchoolingTest, OwnSpeciesInReach)
+{
+ FishStore store;
+ auto &schooling = store.GetSchooling();
+ schooling.SetEnabled(true);
+ schooling.SetRadius(50);
+
+ // Different species, close but not too close
+ auto a = AddFish(store, FishSpecies::Beta, 200, 200, 60, 0);
+ auto b = AddFish(store, FishSpecies::Nemo, 240, 200, 0, 30);
+
+ // Same species, out of reach
+ auto c = AddFish(store, FishSpecies::Dory, 600, 400, 150, 0);
+ auto d = AddFish(store, FishSpecies::Dory, 600, 460, -150, 0);
+
+ store.Update(0.1, 1000, 800);
+ ASSERT_EQ(60, store.GetSpeedX(a));
+ ASSERT_EQ(0, store.GetSpeedY(a));
+ ASSERT_EQ(0, store.GetSpeedX(b));
+ ASSERT_EQ(30, store.GetSpeedY(b));
+ ASSERT_EQ(150, store.GetSpeedX(c));
+ ASSERT_EQ(-150, store.GetSpeedX(d));
+
+ // Turning a species off leaves it alone even in reach
+ SchoolRules rules = schooling.GetRules(FishSpecies::Dory);
+ rules.enabled = false;
+ schooling.SetRules(FishSpecies::Dory, rules);
+ store.SetLocation(d, 610, 400);
+ store.Update(0.1, 1000, 800);
+ ASSERT_EQ(150, store.GetSpeedX(c));
+ ASSERT_EQ(-150, store.GetSpeedX(d));
+}
+
+/**
+ * Fill a store with a crowd of fish of every species
+ * @param store Store to fill
+ * @param count Number of fish
+ */
+static void AddCrowd(FishStore &store, int count)
+{
+ mt19937 random(9);
+ uniform_real_distribution<double> x(0, 1024);
+ uniform_real_distribution<double> y(0, 800);
+ uniform_real_distribution<double> speed(-100, 100);
+ uniform_int_distribution<int> species(1, 3);
+
+ store.Reserve(count);
+ store.GetSchooling().SetEnabled(true);
+ for (int i = 0; i < count; i++)
+ {
+  AddFish(store, (FishSpecies)species(random), x(random), y(random), speed(random), speed(random));
+ }
+}
+
+/**
+ * Schooling gives the same result whatever the number of threads.
+ */
+TEST(SchoolingTest, Threads)
+{
+ const int count = 50000;
+
+ WorkerPool single(1);
+ FishStore expected;
+ expected.SetWorkerPool(&single);
+ AddCrowd(expected, count);
+
+ WorkerPool pool(3);
+ FishStore actual;
+ actual.SetWorkerPool(&pool);
+ AddCrowd(actual, count);
+
+ for (int frame = 0; frame < 5; frame++)
+ {
+  expected.Update(1.0 / 60, 1024, 800);
+  actual.Update(1.0 / 60, 1024, 800);
+ }
+
+ for (int i = 0; i < count; i++)
+ {
+  ASSERT_EQ(expected.GetX(i), actual.GetX(i));
+  ASSERT_EQ(expected.GetY(i), actual.GetY(i));
+  ASSERT_EQ(expected.GetSpeedX(i), actual.GetSpeedX(i));
+  ASSERT_EQ(expected.GetSpeedY(i), actual.GetSpeedY(i));
+  ASSERT_EQ(expected.GetMirror(i), actual.GetMirror(i));
+ }
+}
+
+/**
+ * A big crowd keeps schooling to finite positions and speeds
+ * (Tools/Benchmark times 100,000 fish against the frame budget).
+ */
+TEST(SchoolingTest, Crowd)
+{
+ const int count = 20000;
+ const int steps = 5;
+
+ FishStore store;
+ AddCrowd(store, count);
+
+ for (int step = 0; step < steps; step++)
+ {
+  store.Update(1.0 / 60, 1024, 800);
+ }
+
+ for (int i = 0; i < count; i++)
+ {
+  ASSERT_TRUE(isfinite(store.GetX(i)));
+  ASSERT_TRUE(isfinite(store.GetY(i)));
+  ASSERT_TRUE(isfinite(store.GetSpeedX(i)));
+  ASSERT_TRUE(isfinite(store.GetSpeedY(i)));
+ }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file SessionRecorderTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for recording and replaying sessions.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <wx/filename.h>
+#include <SessionLog.h>
+#include <SessionReplayer.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <DecorCastle.h>
+
+using namespace std;
+
+/// Frames in the recorded session
+const int SessionFrames = 1300;
+
+/**
+ * Record a session in which the user does a bit of everything
+ * @param filename File to record to
+ * @return State hash of the aquarium when recording stopped
+ */
+static uint64_t RecordSession(const wxString &filename)
+{
+ Aquarium aquarium;
+
+ // Something in the tank before recording starts
+ aquarium.Add(make_shared<DecorCastle>(&aquarium));
+ aquarium.Add(make_shared<FishBeta>(&aquarium));
+ aquarium.GetFishes()[1]->SetLocation(300, 300);
+ EXPECT_TRUE(aquarium.StartRecording(filename.ToStdWstring()));
+
+ for (int frame = 0; frame < SessionFrames; frame++)
+ {
+  AquariumCommand command;
+  if (frame % 50 == 0)
+  {
+   command.type = AquariumCommand::Type::Add;
+   command.name = frame % 100 == 0 ? L"nemo" : L"dory";
+  }
+  else if (frame % 50 < 10)
+  {
+   // A drag of the newest item
+   command.type = AquariumCommand::Type::Move;
+   command.item = aquarium.GetFishes().back()->GetHandle();
+   command.x = 100 + frame % 50 * 10;
+   command.y = 400;
+  }
+  else if (frame % 50 == 20)
+  {
+   command.type = AquariumCommand::Type::BringToFront;
+   command.item = aquarium.GetFishes().front()->GetHandle();
+  }
+  else if (frame == 700)
+  {
+   command.type = AquariumCommand::Type::Schooling;
+   command.enabled = true;
+  }
+
+  if (command.type != AquariumCommand::Type::None)
+  {
+   aquarium.Send(std::move(command));
+  }
+
+  aquarium.ExecuteCommands();
+  aquarium.Advance(frame % 7 == 0 ? 0.02 : 1.0 / 60);
+  if (frame == 900)
+  {
+   aquarium.FastForward(3);
+  }
+ }
+
+ auto hash = aquarium.GetStateHash();
+ EXPECT_TRUE(aquarium.StopRecording());
+ return hash;
+}
+
+/**
+ * Everything written to a log reads back the same
+ */
+TEST(SessionRecorderTest, LogRoundTrip)
+{
+ SessionWriter writer;
+ writer.Byte(7);
+ writer.Varint(0);
+ writer.Varint(127);
+ writer.Varint(128);
+ writer.Varint(UINT64_MAX);
+ writer.Double(-0.1);
+ writer.String(L"beta");
+
+ AquariumCommand move;
+ move.type = AquariumCommand::Type::Move;
+ move.item = {3, 9};
+ move.x = 12.5;
+ move.y = 1.0 / 3;
+ writer.Command(move);
+
+ auto &data = writer.GetData();
+ SessionReader reader(data.data(), data.size());
+ ASSERT_EQ(7, reader.Byte());
+ ASSERT_EQ(0u, reader.Varint());
+ ASSERT_EQ(127u, reader.Varint());
+ ASSERT_EQ(128u, reader.Varint());
+ ASSERT_EQ(UINT64_MAX, reader.Varint());
+ ASSERT_EQ(-0.1, reader.Double());
+ ASSERT_EQ(wstring(L"beta"), reader.String());
+
+ AquariumCommand command;
+ ASSERT_EQ(uint8_t(SessionRecord::Command), reader.Byte());
+ ASSERT_TRUE(reader.Command(command));
+ ASSERT_TRUE(command.type == AquariumCommand::Type::Move);
+ ASSERT_TRUE(command.item == move.item);
+ ASSERT_EQ(move.x, command.x);
+ ASSERT_EQ(move.y, command.y);
+
+ ASSERT_TRUE(reader.AtEnd());
+ ASSERT_TRUE(reader.IsOk());
+ reader.Varint();
+ ASSERT_FALSE(reader.IsOk());
+}
+
+/**
+ * A replay of a recorded session ends up in the same state
+ */
+TEST(SessionRecorderTest, ReplayMatches)
+{
+ auto filename = wxFileName::GetTempDir() + L"/aquarium-replay.aqsession";
+ auto hash = RecordSession(filename);
+
+ SessionReplayer replayer;
+ ASSERT_TRUE(replayer.Open(filename.ToStdWstring()));
+
+ Aquarium aquarium;
+ ASSERT_TRUE(replayer.Run(aquarium)) << replayer.GetError();
+ ASSERT_EQ(hash, aquarium.GetStateHash());
+ ASSERT_EQ(uint64_t(SessionFrames), replayer.GetFrames());
+
+ // Two checkpoints and the end
+ ASSERT_EQ(3u, replayer.GetCheckpoints());
+ ASSERT_GT(replayer.GetSimulatedSeconds(), 23);
+
+ // The tank held before recording is there too
+ ASSERT_EQ(2u + SessionFrames / 50, aquarium.GetFishes().size());
+}
+
+/**
+ * A recording stopped by a command, right after another command
+ * in the same batch, still replays to the same state
+ */
+TEST(SessionRecorderTest, ReplayStopCommand)
+{
+ auto filename = wxFileName::GetTempDir() + L"/aquarium-stop.aqsession";
+
+ Aquarium recorded;
+ ASSERT_TRUE(recorded.StartRecording(filename.ToStdWstring()));
+ for (int frame = 0; frame < 10; frame++)
+ {
+  recorded.ExecuteCommands();
+  recorded.Advance(1.0 / 60);
+ }
+
+ AquariumCommand add;
+ add.type = AquariumCommand::Type::Add;
+ add.name = L"beta";
+ recorded.Send(std::move(add));
+
+ AquariumCommand stop;
+ stop.type = AquariumCommand::Type::StopRecording;
+ recorded.Send(std::move(stop));
+ recorded.ExecuteCommands();
+ ASSERT_EQ(1u, recorded.GetFishes().size());
+
+ SessionReplayer replayer;
+ ASSERT_TRUE(replayer.Open(filename.ToStdWstring()));
+
+ Aquarium aquarium;
+ ASSERT_TRUE(replayer.Run(aquarium)) << replayer.GetError();
+ ASSERT_EQ(recorded.GetStateHash(), aquarium.GetStateHash());
+ ASSERT_EQ(1u, aquarium.GetFishes().size());
+}
+
+/**
+ * A replay that goes different, or a log cut short, is caught
+ */
+TEST(SessionRecorderTest, ReplayMismatch)
+{
+ auto filename = wxFileName::GetTempDir() + L"/aquarium-mismatch.aqsession";
+ RecordSession(filename);
+
+ SessionReplayer replayer;
+ ASSERT_TRUE(replayer.Open(filename.ToStdWstring()));
+ auto data = replayer.GetData();
+
+ // A different seed, right after the magic bytes and version
+ auto tampered = data;
+ tampered[6] ^= 1;
+ replayer.SetData(tampered);
+ Aquarium aquarium;
+ ASSERT_FALSE(replayer.Run(aquarium));
+ ASSERT_EQ(wstring(L"State differs at frame 600"), replayer.GetError());
+
+ // Cut short
+ data.resize(data.size() / 2);
+ replayer.SetData(data);
+ Aquarium another;
+ ASSERT_FALSE(replayer.Run(another));
+ ASSERT_FALSE(replayer.GetError().empty());
+
+ // Not a log at all
+ replayer.SetData({'n', 'o', 'p', 'e', 1});
+ ASSERT_FALSE(replayer.Run(another));
+}
@@ -0,0 +1,88 @@
+/**
+ * @file SimulationClockTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the SimulationClock class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <SimulationClock.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+
+/**
+ * Frame time comes out as whole steps with the rest
+ * carried over to the next frame.
+ */
+TEST(SimulationClockTest, Steps)
+{
+ SimulationClock clock(0.01, 5);
+
+ ASSERT_EQ(0, clock.Advance(0.004));
+ ASSERT_NEAR(0.4, clock.GetAlpha(), 0.0001);
+
+ ASSERT_EQ(1, clock.Advance(0.008));
+ ASSERT_NEAR(0.2, clock.GetAlpha(), 0.0001);
+
+ ASSERT_EQ(3, clock.Advance(0.0305));
+ ASSERT_NEAR(0.25, clock.GetAlpha(), 0.0001);
+ ASSERT_EQ(4u, clock.GetTicks());
+
+ // Time never runs backwards
+ ASSERT_EQ(0, clock.Advance(-1));
+ ASSERT_NEAR(0.25, clock.GetAlpha(), 0.0001);
+
+ clock.Reset();
+ ASSERT_EQ(0u, clock.GetTicks());
+ ASSERT_NEAR(0, clock.GetAlpha(), 0.0001);
+}
+
+/**
+ * A long stall runs at most the catch up limit and drops the rest.
+ */
+TEST(SimulationClockTest, CatchUp)
+{
+ SimulationClock clock(0.01, 5);
+
+ ASSERT_EQ(5, clock.Advance(2.0025));
+ ASSERT_NEAR(0.25, clock.GetAlpha(), 0.0001);
+
+ // Back to normal on the next frame
+ ASSERT_EQ(1, clock.Advance(0.01));
+}
+
+/**
+ * A stall in the aquarium moves a fish no more than the catch
+ * up limit allows.
+ */
+TEST(SimulationClockTest, NoTeleport)
+{
+ Aquarium aquarium;
+ auto fish = std::make_shared<FishBeta>(&aquarium);
+ aquarium.Add(fish);
+ fish->SetLocation(500, 400);
+ fish->SetSpeed(50, 0);
+
+ aquarium.Advance(10);
+
+ auto step = aquarium.GetClock().GetStep();
+ ASSERT_NEAR(500 + 50 * step * 5, fish->GetX(), 0.0001);
+}
+
+/**
+ * A fast forward simulates all the time it is asked to, with
+ * nothing dropped.
+ */
+TEST(SimulationClockTest, FastForward)
+{
+ Aquarium aquarium;
+ auto fish = std::make_shared<FishBeta>(&aquarium);
+ aquarium.Add(fish);
+ fish->SetLocation(300, 400);
+ fish->SetSpeed(50, 0);
+
+ ASSERT_EQ(150u, aquarium.FastForward(2.5));
+ ASSERT_EQ(150u, aquarium.GetClock().GetTicks());
+ ASSERT_NEAR(300 + 50 * 2.5, fish->GetX(), 0.0001);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file SnapshotTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the Snapshot, SnapshotBuffer and SimulationThread classes.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Snapshot.h>
+#include <SnapshotBuffer.h>
+#include <SimulationThread.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <DecorCastle.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+/**
+ * A snapshot holds the items back to front with their sprites.
+ */
+TEST(SnapshotTest, Capture)
+{
+ Aquarium aquarium;
+ auto castle = make_shared<DecorCastle>(&aquarium);
+ aquarium.Add(castle);
+ castle->SetLocation(100, 200);
+
+ auto fish = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(fish);
+ fish->SetLocation(300, 400);
+ fish->SetSpeed(10, 0);
+ fish->SetMirror(true);
+ aquarium.Update(1);
+
+ Snapshot snapshot;
+ aquarium.Capture(snapshot);
+
+ auto &entries = snapshot.GetEntries();
+ ASSERT_EQ(2u, entries.size());
+
+ ASSERT_NEAR(100, entries[0].x, 0.0001);
+ ASSERT_NEAR(100, entries[0].prevX, 0.0001);
+ ASSERT_FALSE(entries[0].mirror);
+
+ ASSERT_NEAR(310, entries[1].x, 0.0001);
+ ASSERT_NEAR(300, entries[1].prevX, 0.0001);
+ ASSERT_NEAR(400, entries[1].y, 0.0001);
+ ASSERT_TRUE(entries[1].mirror);
+ ASSERT_NE(entries[0].sprite, entries[1].sprite);
+
+ // Moving the fish after the snapshot leaves the snapshot alone
+ fish->SetLocation(0, 0);
+ ASSERT_NEAR(310, snapshot.GetEntries()[1].x, 0.0001);
+}
+
+/**
+ * The reader always gets the newest published snapshot and
+ * keeps it until it asks again.
+ */
+TEST(SnapshotTest, Buffer)
+{
+ SnapshotBuffer buffer;
+ ASSERT_EQ(nullptr, buffer.Acquire());
+
+ buffer.GetBack().SetTiming(1, 0.01, 0);
+ buffer.Publish();
+ auto front = buffer.Acquire();
+ ASSERT_NE(nullptr, front);
+ ASSERT_EQ(1u, front->GetTick());
+
+ // Nothing new, same snapshot
+ ASSERT_EQ(front, buffer.Acquire());
+
+ // Two publishes, the reader skips to the newest
+ buffer.GetBack().SetTiming(2, 0.01, 0);
+ buffer.Publish();
+ buffer.GetBack().SetTiming(3, 0.01, 0);
+ buffer.Publish();
+ ASSERT_EQ(1u, front->GetTick());
+ ASSERT_EQ(3u, buffer.Acquire()->GetTick());
+}
+
+/**
+ * With a writer and reader on different threads the reader
+ * sees ticks that only ever go up and are never half written.
+ */
+TEST(SnapshotTest, BufferThreads)
+{
+ SnapshotBuffer buffer;
+ const uint64_t last = 200000;
+
+ thread writer([&]() {
+  for (uint64_t tick = 1; tick <= last; tick++)
+  {
+   auto &back = buffer.GetBack();
+   back.Clear();
+   back.SetTiming(tick, 0.01, 0);
+   buffer.Publish();
+  }
+ });
+
+ uint64_t seen = 0;
+ while (seen < last)
+ {
+  auto snapshot = buffer.Acquire();
+  if (snapshot != nullptr)
+  {
+   ASSERT_GE(snapshot->GetTick(), seen);
+   seen = snapshot->GetTick();
+  }
+ }
+
+ writer.join();
+}
+
+/**
+ * The simulation thread steps the aquarium and publishes
+ * snapshots on its own.
+ */
+TEST(SnapshotTest, SimulationThread)
+{
+ Aquarium aquarium;
+ {
+  auto lock = aquarium.Lock();
+  auto fish = make_shared<FishBeta>(&aquarium);
+  aquarium.Add(fish);
+  fish->SetSpeed(100, 0);
+ }
+
+ SimulationThread simulation(&aquarium);
+ simulation.Start();
+
+ const Snapshot *snapshot = nullptr;
+ auto start = chrono::steady_clock::now();
+ while (chrono::steady_clock::now() - start < chrono::seconds(5))
+ {
+  snapshot = aquarium.GetSnapshots().Acquire();
+  if (snapshot != nullptr && snapshot->GetTick() >= 3)
+  {
+   break;
+  }
+
+  this_thread::sleep_for(chrono::milliseconds(5));
+ }
+
+ simulation.Stop();
+
+ ASSERT_NE(nullptr, snapshot);
+ ASSERT_GE(snapshot->GetTick(), 3u);
+ ASSERT_EQ(1u, snapshot->GetEntries().size());
+ ASSERT_GT(snapshot->GetEntries()[0].x, 200);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file SpatialGridTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the SpatialGrid class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <SpatialGrid.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <DecorCastle.h>
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+/**
+ * Queries find exactly what checking every point finds,
+ * including points outside the grid.
+ */
+TEST(SpatialGridTest, MatchesBruteForce)
+{
+ const int count = 5000;
+ mt19937 random(3);
+ uniform_real_distribution<double> coordinate(-100, 1100);
+ vector<double> x(count), y(count);
+ for (int i = 0; i < count; i++)
+ {
+  x[i] = coordinate(random);
+  y[i] = coordinate(random);
+ }
+
+ SpatialGrid grid;
+ grid.Resize(1000, 800, 50);
+ ASSERT_EQ(20, grid.GetColumns());
+ ASSERT_EQ(16, grid.GetRows());
+
+ grid.Build(x.data(), y.data(), count);
+ ASSERT_EQ((size_t)count, grid.GetCount());
+
+ vector<int> found;
+ for (int query = 0; query < 200; query++)
+ {
+  auto cx = coordinate(random);
+  auto cy = coordinate(random);
+  auto radius = query % 3 == 0 ? 5.0 : 120.0;
+
+  vector<int> expected;
+  for (int i = 0; i < count; i++)
+  {
+   auto dx = x[i] - cx;
+   auto dy = y[i] - cy;
+   if (dx * dx + dy * dy <= radius * radius)
+   {
+    expected.push_back(i);
+   }
+  }
+
+  grid.QueryRadius(cx, cy, radius, found);
+  sort(found.begin(), found.end());
+  ASSERT_EQ(expected, found);
+
+  expected.clear();
+  for (int i = 0; i < count; i++)
+  {
+   if (x[i] >= cx && x[i] <= cx + radius * 2 && y[i] >= cy - radius && y[i] <= cy)
+   {
+    expected.push_back(i);
+   }
+  }
+
+  grid.QueryRect(cx, cy - radius, cx + radius * 2, cy, found);
+  sort(found.begin(), found.end());
+  ASSERT_EQ(expected, found);
+ }
+
+ // Building again replaces the points
+ grid.Build(x.data(), y.data(), 1);
+ grid.QueryRect(-1000, -1000, 2000, 2000, found);
+ ASSERT_EQ(vector<int>{0}, found);
+}
+
+/**
+ * The aquarium answers which items are near a place,
+ * back to front.
+ */
+TEST(SpatialGridTest, Aquarium)
+{
+ Aquarium aquarium;
+ auto castle = make_shared<DecorCastle>(&aquarium);
+ auto beta1 = make_shared<FishBeta>(&aquarium);
+ auto beta2 = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(castle);
+ aquarium.Add(beta1);
+ aquarium.Add(beta2);
+
+ castle->SetLocation(100, 100);
+ beta1->SetLocation(130, 100);
+ beta2->SetLocation(600, 500);
+ aquarium.UpdateGrid();
+
+ vector<Item *> items;
+ aquarium.QueryRadius(110, 100, 25, items);
+ ASSERT_EQ(2u, items.size());
+ ASSERT_EQ(castle.get(), items[0]);
+ ASSERT_EQ(beta1.get(), items[1]);
+
+ aquarium.QueryRect(500, 400, 700, 600, items);
+ ASSERT_EQ(vector<Item *>{beta2.get()}, items);
+
+ // Advancing keeps the grid up to date with the items
+ aquarium.MoveToFront(castle->GetHandle());
+ aquarium.Advance(0);
+ aquarium.QueryRadius(110, 100, 25, items);
+ ASSERT_EQ(2u, items.size());
+ ASSERT_EQ(beta1.get(), items[0]);
+ ASSERT_EQ(castle.get(), items[1]);
+}
+
+/**
+ * Build a grid of many points and query around each of a
+ * sample of them (Tools/Benchmark times a million).
+ */
+TEST(SpatialGridTest, ManyPoints)
+{
+ const int count = 100000;
+ mt19937 random(1);
+ uniform_real_distribution<double> x(0, 1024);
+ uniform_real_distribution<double> y(0, 800);
+ vector<double> xs(count), ys(count);
+ for (int i = 0; i < count; i++)
+ {
+  xs[i] = x(random);
+  ys[i] = y(random);
+ }
+
+ SpatialGrid grid;
+ grid.Resize(1024, 800, 16);
+
+ grid.Build(xs.data(), ys.data(), count);
+
+ size_t found = 0;
+ for (int i = 0; i < count; i += 100)
+ {
+  grid.ForEachInRadius(xs[i], ys[i], 8, [&found](int, double, double) { found++; });
+ }
+
+ // Every query at least finds the point it is centered on
+ ASSERT_GE(found, (size_t)(count / 100));
+}
@@ -0,0 +1,78 @@
+/**
+ * @file SpeciesFishTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the SpeciesFish class template and ItemFactory.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <FishNemo.h>
+#include <FishDory.h>
+#include <DecorCastle.h>
+#include <ItemFactory.h>
+
+using namespace std;
+
+/**
+ * A fish starts out as its species' traits say
+ */
+TEST(SpeciesFishTest, Traits)
+{
+ Aquarium aquarium;
+ typedef FishNemo::Traits Traits;
+
+ for (int i = 0; i < 100; i++)
+ {
+  auto nemo = make_shared<FishNemo>(&aquarium);
+  ASSERT_GE(nemo->GetSpeedX(), Traits::MinSpeedX);
+  ASSERT_LE(nemo->GetSpeedX(), Traits::MaxSpeedX);
+  ASSERT_GE(nemo->GetSpeedY(), Traits::MinSpeedY);
+  ASSERT_LE(nemo->GetSpeedY(), Traits::MaxSpeedY);
+
+  wxXmlNode root(wxXML_ELEMENT_NODE, L"aqua");
+  ASSERT_EQ(wxString(L"nemo"), nemo->XmlSave(&root)->GetAttribute(L"type"));
+ }
+}
+
+/**
+ * The aquarium creates every type from its name and nothing
+ * from names it does not know
+ */
+TEST(SpeciesFishTest, CreateByName)
+{
+ Aquarium aquarium;
+ wxXmlNode root(wxXML_ELEMENT_NODE, L"aqua");
+
+ for (auto type : {L"beta", L"nemo", L"dory", L"castle"})
+ {
+  auto item = aquarium.Create(type);
+  ASSERT_NE(nullptr, item);
+  ASSERT_EQ(wxString(type), item->XmlSave(&root)->GetAttribute(L"type"));
+ }
+
+ ASSERT_NE(nullptr, dynamic_pointer_cast<FishDory>(aquarium.Create(L"dory")));
+ ASSERT_NE(nullptr, dynamic_pointer_cast<DecorCastle>(aquarium.Create(L"castle")));
+ ASSERT_EQ(nullptr, aquarium.Create(L"shark"));
+ ASSERT_EQ(nullptr, aquarium.Create(L""));
+}
+
+/**
+ * A factory can be made for any list of types
+ */
+TEST(SpeciesFishTest, Factory)
+{
+ typedef ItemFactory<FishDory, DecorCastle> Factory;
+ static_assert(Factory::Names.Find(L"castle") == 1, "Types are found at compile time");
+
+ Aquarium aquarium;
+ auto arena = make_shared<ItemArena>();
+ auto dory = Factory::Create(L"dory", &aquarium, arena);
+ ASSERT_NE(nullptr, dory);
+ ASSERT_EQ(nullptr, Factory::Create(L"beta", &aquarium, arena));
+
+ // Made in the arena it was given
+ ASSERT_EQ(1u, arena->GetLive());
+}
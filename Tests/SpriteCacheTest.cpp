@@ -0,0 +1,153 @@
+/**
+ * @file SpriteCacheTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the SpriteCache class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <SpriteCache.h>
+#include <Sprite.h>
+#include <SpriteAtlas.h>
+#include <Aquarium.h>
+#include <FishBeta.h>
+#include <DecorCastle.h>
+#include <Snapshot.h>
+#include <thread>
+
+/// Fish filename
+const std::wstring SpriteCacheBetaImageName = L"images/beta.png";
+
+/**
+ * Loading the same file twice hands out the same sprite and
+ * only decodes it once.
+ */
+TEST(SpriteCacheTest, SharedSprite)
+{
+ auto &cache = SpriteCache::Instance();
+ cache.Clear();
+
+ auto sprite1 = cache.Load(SpriteCacheBetaImageName);
+ ASSERT_EQ(1u, cache.GetMisses());
+ ASSERT_EQ(0u, cache.GetHits());
+
+ auto sprite2 = cache.Load(SpriteCacheBetaImageName);
+ ASSERT_EQ(sprite1, sprite2);
+ ASSERT_EQ(1u, cache.GetMisses());
+ ASSERT_EQ(1u, cache.GetHits());
+ ASSERT_EQ(1u, cache.GetCount());
+
+ ASSERT_EQ(125, sprite1->GetWidth());
+ ASSERT_EQ(117, sprite1->GetHeight());
+ ASSERT_EQ(sprite1->GetResidentBytes(), cache.GetResidentBytes());
+}
+
+/**
+ * Many fish of one species only decode the image once.
+ */
+TEST(SpriteCacheTest, ManyFish)
+{
+ auto &cache = SpriteCache::Instance();
+ cache.Clear();
+
+ Aquarium aquarium;
+ auto misses = cache.GetMisses();
+
+ for (int i = 0; i < 100; i++)
+ {
+  aquarium.Add(std::make_shared<FishBeta>(&aquarium));
+ }
+
+ ASSERT_EQ(misses + 1, cache.GetMisses());
+ ASSERT_GE(cache.GetHits(), 99u);
+}
+
+/**
+ * The atlas holds every small sprite in both orientations and
+ * leaves the background out.
+ */
+TEST(SpriteCacheTest, Atlas)
+{
+ auto &cache = SpriteCache::Instance();
+ cache.Clear();
+
+ ASSERT_GE(cache.LoadDirectory(L"images"), 7);
+ ASSERT_EQ(nullptr, cache.GetAtlas());
+
+ cache.BuildAtlas();
+ auto atlas = cache.GetAtlas();
+ ASSERT_NE(nullptr, atlas);
+
+ auto beta = cache.Load(SpriteCacheBetaImageName);
+ auto background = cache.Load(L"images/background1.png");
+ ASSERT_TRUE(atlas->Contains(*beta));
+ ASSERT_FALSE(atlas->Contains(*background));
+
+ auto &normal = atlas->GetRegion(*beta, false);
+ auto &mirror = atlas->GetRegion(*beta, true);
+ ASSERT_EQ(beta->GetWidth(), normal.width);
+ ASSERT_EQ(beta->GetHeight(), mirror.height);
+
+ // Spot check the copied pixels against the sprite images
+ auto &image = atlas->GetImage();
+ for (int y = 0; y < beta->GetHeight(); y += 7)
+ {
+  for (int x = 0; x < beta->GetWidth(); x += 5)
+  {
+   ASSERT_EQ(beta->GetImage(false).IsTransparent(x, y), image.IsTransparent(normal.x + x, normal.y + y));
+   ASSERT_EQ(beta->GetImage(true).IsTransparent(x, y), image.IsTransparent(mirror.x + x, mirror.y + y));
+  }
+ }
+}
+
+/**
+ * Once the GUI thread is named, other threads only get sprites
+ * that already exist and never make one.
+ */
+TEST(SpriteCacheTest, GuiThread)
+{
+ auto &cache = SpriteCache::Instance();
+ cache.Clear();
+ auto beta = cache.Load(SpriteCacheBetaImageName);
+ cache.SetGuiThread();
+
+ std::shared_ptr<const Sprite> found, missing;
+ std::thread other([&]() {
+  found = cache.Load(SpriteCacheBetaImageName);
+  missing = cache.Load(L"images/nemo.png");
+ });
+ other.join();
+
+ ASSERT_EQ(beta, found);
+ ASSERT_NE(nullptr, missing);
+ ASSERT_EQ(1, missing->GetWidth());
+ ASSERT_FALSE(missing->GetHitMask().Test(0, 0));
+ ASSERT_EQ(1u, cache.GetCount());
+
+ // The GUI thread still makes them
+ auto nemo = cache.Load(L"images/nemo.png");
+ ASSERT_GT(nemo->GetWidth(), 1);
+ ASSERT_EQ(2u, cache.GetCount());
+
+ // An item the other thread makes from the stand in can be captured,
+ // drawn and hit tested like any other
+ Aquarium aquarium;
+ std::shared_ptr<Item> castle;
+ std::thread maker([&]() { castle = std::make_shared<DecorCastle>(&aquarium); });
+ maker.join();
+ aquarium.Add(castle);
+ castle->SetLocation(100, 100);
+
+ Snapshot snapshot;
+ aquarium.Capture(snapshot);
+ ASSERT_EQ(1u, snapshot.GetEntries().size());
+ ASSERT_EQ(missing->GetId(), snapshot.GetEntries()[0].sprite);
+ ASSERT_TRUE(snapshot.HitTest(100, 100).IsNull());
+
+ wxBitmap bitmap(aquarium.GetWidth(), aquarium.GetHeight());
+ wxMemoryDC dc(bitmap);
+ snapshot.Draw(&dc, 1, nullptr);
+
+ cache.SetGuiThread(std::thread::id());
+}
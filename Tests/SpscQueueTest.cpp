@@ -0,0 +1,87 @@
+/**
+ * @file SpscQueueTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the SpscQueue class template.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <SpscQueue.h>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Values come out in order, and a full queue refuses
+ * more without losing the value.
+ */
+TEST(SpscQueueTest, PushPop)
+{
+ SpscQueue<unique_ptr<int>> queue(3);
+ ASSERT_EQ(4u, queue.GetCapacity());
+
+ unique_ptr<int> value;
+ ASSERT_FALSE(queue.TryPop(value));
+
+ for (int i = 0; i < 4; i++)
+ {
+  ASSERT_TRUE(queue.TryPush(make_unique<int>(i)));
+ }
+
+ auto extra = make_unique<int>(99);
+ ASSERT_FALSE(queue.TryPush(std::move(extra)));
+ ASSERT_NE(nullptr, extra);
+
+ for (int i = 0; i < 4; i++)
+ {
+  ASSERT_TRUE(queue.TryPop(value));
+  ASSERT_EQ(i, *value);
+ }
+
+ ASSERT_FALSE(queue.TryPop(value));
+
+ // Room again after popping
+ ASSERT_TRUE(queue.TryPush(std::move(extra)));
+ ASSERT_TRUE(queue.TryPop(value));
+ ASSERT_EQ(99, *value);
+}
+
+/**
+ * Everything pushed on one thread arrives once and in
+ * order on another.
+ */
+TEST(SpscQueueTest, Threads)
+{
+ SpscQueue<int> queue(64);
+ const int count = 20000;
+
+ thread producer([&]() {
+  for (int i = 0; i < count; i++)
+  {
+   while (!queue.TryPush(int(i)))
+   {
+    this_thread::yield();
+   }
+  }
+ });
+
+ int expected = 0;
+ while (expected < count)
+ {
+  int value;
+  if (queue.TryPop(value))
+  {
+   ASSERT_EQ(expected, value);
+   expected++;
+  }
+  else
+  {
+   // Let the producer run, there may be only one core
+   this_thread::yield();
+  }
+ }
+
+ producer.join();
+}
@@ -0,0 +1,107 @@
+/**
+ * @file StaticLayerTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the StaticLayer class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <Aquarium.h>
+#include <DecorCastle.h>
+#include <FishBeta.h>
+#include <Snapshot.h>
+#include <StaticLayer.h>
+
+using namespace std;
+
+/**
+ * Only the decor behind every fish counts as static.
+ */
+TEST(StaticLayerTest, StaticCount)
+{
+ Aquarium aquarium;
+ auto castle1 = make_shared<DecorCastle>(&aquarium);
+ auto castle2 = make_shared<DecorCastle>(&aquarium);
+ auto beta = make_shared<FishBeta>(&aquarium);
+ auto castle3 = make_shared<DecorCastle>(&aquarium);
+ ASSERT_TRUE(castle1->IsStatic());
+ ASSERT_FALSE(beta->IsStatic());
+
+ aquarium.Add(castle1);
+ aquarium.Add(castle2);
+ aquarium.Add(beta);
+ aquarium.Add(castle3);
+
+ Snapshot snapshot;
+ aquarium.Capture(snapshot);
+ ASSERT_EQ(2u, snapshot.GetStaticCount());
+
+ // With the fish at the front all the decor is behind it
+ aquarium.MoveToFront(beta->GetHandle());
+ aquarium.Capture(snapshot);
+ ASSERT_EQ(3u, snapshot.GetStaticCount());
+}
+
+/**
+ * The layer is only drawn again when static items change.
+ */
+TEST(StaticLayerTest, Rebuild)
+{
+ Aquarium aquarium;
+ auto castle = make_shared<DecorCastle>(&aquarium);
+ auto beta = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(castle);
+ aquarium.Add(beta);
+
+ wxBitmap bitmap(aquarium.GetWidth(), aquarium.GetHeight());
+ wxMemoryDC dc(bitmap);
+
+ StaticLayer layer;
+ Snapshot snapshot;
+ auto draw = [&]() {
+  aquarium.Capture(snapshot);
+  snapshot.Draw(&dc, 1, &layer);
+ };
+
+ draw();
+ draw();
+ ASSERT_EQ(1, layer.GetBuilds());
+
+ // Fish moving does not touch the layer
+ beta->SetLocation(500, 500);
+ aquarium.Advance(0.1);
+ draw();
+ ASSERT_EQ(1, layer.GetBuilds());
+
+ // Moving, adding and reordering decor does
+ castle->SetLocation(300, 300);
+ draw();
+ ASSERT_EQ(2, layer.GetBuilds());
+
+ aquarium.Add(make_shared<DecorCastle>(&aquarium));
+ draw();
+ ASSERT_EQ(3, layer.GetBuilds());
+ ASSERT_EQ(1u, snapshot.GetStaticCount());
+
+ aquarium.MoveToFront(beta->GetHandle());
+ draw();
+ ASSERT_EQ(4, layer.GetBuilds());
+ ASSERT_EQ(2u, snapshot.GetStaticCount());
+
+ // Bringing a fish to the front past other fish does not
+ auto beta2 = make_shared<FishBeta>(&aquarium);
+ aquarium.Add(beta2);
+ draw();
+ aquarium.MoveToFront(beta->GetHandle());
+ draw();
+ aquarium.MoveToFront(beta2->GetHandle());
+ draw();
+ ASSERT_EQ(4, layer.GetBuilds());
+
+ aquarium.Clear(L"");
+ draw();
+ ASSERT_EQ(5, layer.GetBuilds());
+ draw();
+ ASSERT_EQ(5, layer.GetBuilds());
+}
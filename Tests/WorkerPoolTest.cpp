@@ -0,0 +1,67 @@
+/**
+ * @file WorkerPoolTest.cpp
+ * @author Yeji Lee
+ *
+ * Unit tests for the WorkerPool class.
+ */
+
+#include <pch.h>
+#include <gtest/gtest.h>
+#include <WorkerPool.h>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Every index is handed out exactly once, for any number
+ * of threads and any size of range.
+ */
+TEST(WorkerPoolTest, Coverage)
+{
+ for (int threads : {1, 2, 3, 8})
+ {
+  WorkerPool pool(threads);
+  ASSERT_EQ(threads, pool.GetThreadCount());
+
+  for (size_t count : {0, 1, 99, 100, 101, 10007})
+  {
+   vector<atomic<int>> seen(count);
+   for (auto &s : seen)
+   {
+    s = 0;
+   }
+
+   pool.Run(count, 100, [&](size_t begin, size_t end) {
+    ASSERT_LE(end - begin, 100u);
+    for (auto i = begin; i < end; i++)
+    {
+     seen[i]++;
+    }
+   });
+
+   for (size_t i = 0; i < count; i++)
+   {
+    ASSERT_EQ(1, seen[i]) << threads << " threads, " << count << " items, index " << i;
+   }
+  }
+ }
+}
+
+/**
+ * The pool can run many small jobs back to back.
+ */
+TEST(WorkerPoolTest, Repeat)
+{
+ WorkerPool pool(4);
+ atomic<size_t> total{0};
+
+ for (int run = 0; run < 1000; run++)
+ {
+  pool.Run(64, 4, [&](size_t begin, size_t end) {
+   total += end - begin;
+  });
+ }
+
+ ASSERT_EQ(64000u, total);
+}
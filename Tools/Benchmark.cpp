@@ -0,0 +1,328 @@
+/**
+ * @file Benchmark.cpp
+ * @author Yeji Lee
+ *
+ * Tool that times the hot paths of the simulation at the sizes
+ * they are meant to handle, so timing stays out of the unit tests.
+ *
+ * Usage: Benchmark [name...]
+ *
+ * Runs the named benchmarks, or every one of them, and prints the
+ * times. Exits with 1 if a benchmark with a time budget went over it,
+ * such as schooling, which has to keep 100,000 fish at 30 frames a second.
+ */
+
+#include <pch.h>
+#include <wx/init.h>
+#include <Aquarium.h>
+#include <AssetLoader.h>
+#include <FishKernel.h>
+#include <FishStore.h>
+#include <SpatialGrid.h>
+#include <SpriteCache.h>
+#include <WorkerPool.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/// Width of the tank the fish move in
+const double TankWidth = 1024;
+
+/// Height of the tank the fish move in
+const double TankHeight = 800;
+
+/**
+ * Seconds since a time
+ * @param start The time
+ * @return Seconds of wall clock time since then
+ */
+static double Since(chrono::steady_clock::time_point start)
+{
+ return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Fill a store with fish spread over the tank
+ * @param store Store to fill
+ * @param count Number of fish
+ * @param schooling Make the fish of every species and turn schooling on
+ */
+static void AddFish(FishStore &store, int count, bool schooling)
+{
+ mt19937 random(1);
+ uniform_real_distribution<double> x(100, TankWidth - 100);
+ uniform_real_distribution<double> y(100, TankHeight - 100);
+ uniform_real_distribution<double> speed(-100, 100);
+ uniform_int_distribution<int> species(1, 3);
+
+ store.Reserve(count);
+ store.GetSchooling().SetEnabled(schooling);
+ for (int i = 0; i < count; i++)
+ {
+  auto slot = store.Add(60, 55);
+  if (schooling)
+  {
+   store.SetSpecies(slot, (FishSpecies)species(random));
+  }
+  store.SetLocation(slot, x(random), y(random));
+  store.SetSpeed(slot, speed(random), speed(random));
+ }
+}
+
+/**
+ * Time every supported kernel at a few tank sizes
+ * @return true, there is no budget
+ */
+static bool Kernels()
+{
+ const FishKernel::Level levels[] = {FishKernel::Level::Scalar, FishKernel::Level::SSE2, FishKernel::Level::AVX2};
+ const int frames = 20;
+
+ cout << "Best kernel: " << FishKernel::GetName(FishKernel::GetBestLevel()) << endl;
+
+ for (size_t count : {10000, 100000, 1000000})
+ {
+  mt19937 random(7);
+  uniform_real_distribution<double> across(-20, TankWidth + 20);
+  uniform_real_distribution<double> down(-20, TankHeight + 20);
+  uniform_real_distribution<double> speed(-100, 100);
+
+  vector<double> x(count), y(count), speedX(count), speedY(count), halfWidth(count, 30), halfHeight(count, 25);
+  vector<uint8_t> mirror(count);
+  for (size_t i = 0; i < count; i++)
+  {
+   x[i] = across(random);
+   y[i] = down(random);
+   speedX[i] = speed(random);
+   speedY[i] = speed(random);
+  }
+
+  FishBatch batch;
+  batch.x = x.data();
+  batch.y = y.data();
+  batch.speedX = speedX.data();
+  batch.speedY = speedY.data();
+  batch.halfWidth = halfWidth.data();
+  batch.halfHeight = halfHeight.data();
+  batch.mirror = mirror.data();
+  batch.count = count;
+
+  for (auto level : levels)
+  {
+   if (!FishKernel::IsSupported(level))
+   {
+    continue;
+   }
+
+   auto start = chrono::steady_clock::now();
+   for (int frame = 0; frame < frames; frame++)
+   {
+    FishKernel::Move(level, batch, 0.03, TankWidth, TankHeight);
+   }
+
+   cout << "  " << count << " fish, " << FishKernel::GetName(level) << ": "
+        << Since(start) * 1000 / frames << " ms per frame" << endl;
+  }
+ }
+
+ return true;
+}
+
+/**
+ * Time a frame of a million fish in the store, every system and thread
+ * @return true, there is no budget
+ */
+static bool Store()
+{
+ const int count = 1000000;
+ const int frames = 10;
+
+ FishStore store;
+ AddFish(store, count, false);
+
+ auto start = chrono::steady_clock::now();
+ for (int frame = 0; frame < frames; frame++)
+ {
+  store.Update(0.03, TankWidth, TankHeight);
+ }
+
+ cout << "  " << count << " fish, " << WorkerPool::Instance().GetThreadCount() << " threads: "
+      << Since(start) * 1000 / frames << " ms per frame" << endl;
+ return true;
+}
+
+/**
+ * Time building a grid of a million points and querying around a sample
+ * @return true, there is no budget
+ */
+static bool Grid()
+{
+ const int count = 1000000;
+ mt19937 random(1);
+ uniform_real_distribution<double> x(0, TankWidth);
+ uniform_real_distribution<double> y(0, TankHeight);
+ vector<double> xs(count), ys(count);
+ for (int i = 0; i < count; i++)
+ {
+  xs[i] = x(random);
+  ys[i] = y(random);
+ }
+
+ SpatialGrid grid;
+ grid.Resize(TankWidth, TankHeight, 16);
+
+ auto start = chrono::steady_clock::now();
+ grid.Build(xs.data(), ys.data(), count);
+ auto build = Since(start);
+
+ start = chrono::steady_clock::now();
+ size_t found = 0;
+ for (int i = 0; i < count; i += 100)
+ {
+  grid.ForEachInRadius(xs[i], ys[i], 8, [&found](int, double, double) { found++; });
+ }
+
+ cout << "  " << count << " points: build " << build * 1000 << " ms, " << count / 100 << " queries "
+      << Since(start) * 1000 << " ms, " << found << " found" << endl;
+ return true;
+}
+
+/**
+ * Time a hundred thousand schooling fish against the frame budget.
+ *
+ * At 30 frames a second with 60 steps a second, two steps have
+ * to fit in a frame of 33 ms.
+ *
+ * @return true if a frame fits the budget
+ */
+static bool School()
+{
+ const int count = 100000;
+ const int frames = 10;
+ const int stepsPerFrame = 2;
+ const double budget = 1000.0 / 30;
+
+ FishStore store;
+ AddFish(store, count, true);
+
+ // One frame first, so the grid and arrays are all allocated
+ store.Update(1.0 / 60, TankWidth, TankHeight, stepsPerFrame);
+
+ auto start = chrono::steady_clock::now();
+ for (int frame = 0; frame < frames; frame++)
+ {
+  for (int step = 0; step < stepsPerFrame; step++)
+  {
+   store.Update(1.0 / 60, TankWidth, TankHeight);
+  }
+ }
+ auto frame = Since(start) * 1000 / frames;
+
+ bool met = frame <= budget;
+ cout << "  " << count << " schooling fish, " << WorkerPool::Instance().GetThreadCount() << " threads: "
+      << frame << " ms per frame of " << stepsPerFrame << " steps, budget " << budget << " ms: "
+      << (met ? "met" : "OVER BUDGET") << endl;
+ return met;
+}
+
+/**
+ * Time bringing items to the front in a big aquarium
+ * @return true, there is no budget
+ */
+static bool Handles()
+{
+ const int count = 100000;
+
+ Aquarium aquarium;
+ vector<ItemHandle> handles;
+ for (int i = 0; i < count; i++)
+ {
+  auto item = aquarium.Create(L"castle");
+  aquarium.Add(item);
+  handles.push_back(item->GetHandle());
+ }
+
+ auto start = chrono::steady_clock::now();
+ for (int i = 0; i < count; i++)
+ {
+  aquarium.MoveToFront(handles[(i * 7919) % count]);
+ }
+
+ cout << "  " << count << " items, " << count << " moves to front: " << Since(start) * 1000 << " ms" << endl;
+ return true;
+}
+
+/// A benchmark and the name it is run by
+struct Entry {
+ const char *name;       ///< Name on the command line
+ bool (*run)();          ///< Runs it, false if it went over its budget
+};
+
+/// Every benchmark, in the order they run
+const Entry Benchmarks[] = {
+ {"kernel", &Kernels},
+ {"store", &Store},
+ {"grid", &Grid},
+ {"schooling", &School},
+ {"handles", &Handles},
+};
+
+/**
+ * Program entry point
+ * @param argc Number of arguments
+ * @param argv The arguments
+ * @return 0 if every budget was met
+ */
+int main(int argc, char **argv)
+{
+ for (int a = 1; a < argc; a++)
+ {
+  bool known = false;
+  for (auto &benchmark : Benchmarks)
+  {
+   known = known || strcmp(argv[a], benchmark.name) == 0;
+  }
+
+  if (!known)
+  {
+   cerr << "Usage: Benchmark [name...], names are:";
+   for (auto &benchmark : Benchmarks)
+   {
+    cerr << " " << benchmark.name;
+   }
+   cerr << endl;
+   return 1;
+  }
+ }
+
+ wxInitializer initializer;
+ wxInitAllImageHandlers();
+
+ auto &sprites = SpriteCache::Instance();
+ if (sprites.LoadEmbedded() == 0)
+ {
+  sprites.SetRoot(AssetLoader::FindRoot(L"images"));
+ }
+
+ bool met = true;
+ for (auto &benchmark : Benchmarks)
+ {
+  bool wanted = argc == 1;
+  for (int a = 1; a < argc; a++)
+  {
+   wanted = wanted || strcmp(argv[a], benchmark.name) == 0;
+  }
+
+  if (wanted)
+  {
+   cout << benchmark.name << ":" << endl;
+   met = benchmark.run() && met;
+  }
+ }
+
+ return met ? 0 : 1;
+}
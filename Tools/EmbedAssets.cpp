@@ -0,0 +1,108 @@
+/**
+ * @file EmbedAssets.cpp
+ * @author Yeji Lee
+ *
+ * Build time tool that decodes images and writes them out as C++
+ * arrays for AquariumLib to compile in.
+ *
+ * Usage: EmbedAssets output.inc root image...
+ *
+ * Each image is named by its path relative to root, which is how
+ * items ask the sprite cache for it (L"images/beta.png").
+ */
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+#include <wx/init.h>
+#include <wx/filename.h>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+/// Values written on each line of an array
+const int ValuesPerLine = 24;
+
+/**
+ * Write a byte array definition
+ * @param out Stream to write to
+ * @param name Name of the array
+ * @param data The bytes
+ * @param size Number of bytes
+ */
+static void WriteArray(ostream &out, const string &name, const unsigned char *data, size_t size)
+{
+ out << "static const unsigned char " << name << "[] = {";
+ for (size_t i = 0; i < size; i++)
+ {
+  if (i % ValuesPerLine == 0)
+  {
+   out << "\n";
+  }
+  out << (int)data[i] << ",";
+ }
+ out << "\n};\n\n";
+}
+
+/**
+ * Program entry point
+ * @param argc Number of arguments
+ * @param argv The arguments
+ * @return 0 on success
+ */
+int main(int argc, char **argv)
+{
+ if (argc < 3)
+ {
+  cerr << "Usage: EmbedAssets output.inc root image..." << endl;
+  return 1;
+ }
+
+ wxInitializer initializer;
+ wxInitAllImageHandlers();
+
+ ofstream out(argv[1]);
+ if (!out)
+ {
+  cerr << "EmbedAssets: unable to write " << argv[1] << endl;
+  return 1;
+ }
+
+ out << "// Generated by EmbedAssets, do not edit.\n\n";
+
+ wxString root = wxFileName(argv[2]).GetFullPath();
+ string table;
+
+ for (int i = 3; i < argc; i++)
+ {
+  wxImage image(argv[i], wxBITMAP_TYPE_ANY);
+  if (!image.IsOk())
+  {
+   cerr << "EmbedAssets: unable to decode " << argv[i] << endl;
+   return 1;
+  }
+
+  wxFileName path(argv[i]);
+  path.MakeRelativeTo(root);
+  auto name = path.GetFullPath(wxPATH_UNIX);
+
+  auto prefix = "Asset" + to_string(i - 3);
+  WriteArray(out, prefix + "RGB", image.GetData(), size_t(image.GetWidth()) * image.GetHeight() * 3);
+
+  string alpha = "nullptr";
+  if (image.HasAlpha())
+  {
+   alpha = prefix + "Alpha";
+   WriteArray(out, alpha, image.GetAlpha(), size_t(image.GetWidth()) * image.GetHeight());
+  }
+
+  table += " {L\"" + name.ToStdString() + "\", " + to_string(image.GetWidth()) + ", " +
+          to_string(image.GetHeight()) + ", " + prefix + "RGB, " + alpha + "},\n";
+ }
+
+ out << "static const EmbeddedAsset EmbeddedAssetTable[] = {\n" << table << "};\n";
+
+ return out ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file FastForward.cpp
+ * @author Yeji Lee
+ *
+ * Tool that simulates a tank for a stretch of time as fast as it
+ * will go, with no window, to age it before a demo or soak test it.
+ *
+ * Usage: FastForward tank.aqua seconds [aged.aqua]
+ *
+ * Reports how many simulated seconds ran per wall clock second,
+ * and saves the aged tank if given a file to save it to.
+ */
+
+#include <pch.h>
+#include <wx/init.h>
+#include <Aquarium.h>
+#include <AssetLoader.h>
+#include <SpriteCache.h>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+/// Most progress lines printed for one run
+const int ProgressReports = 10;
+
+/**
+ * Program entry point
+ * @param argc Number of arguments
+ * @param argv The arguments
+ * @return 0 on success
+ */
+int main(int argc, char **argv)
+{
+ double seconds = 0;
+ if (argc < 3 || argc > 4 || !wxString(argv[2]).ToDouble(&seconds) || seconds < 0)
+ {
+  cerr << "Usage: FastForward tank.aqua seconds [aged.aqua]" << endl;
+  return 1;
+ }
+
+ wxInitializer initializer;
+ wxInitAllImageHandlers();
+
+ auto &sprites = SpriteCache::Instance();
+ if (sprites.LoadEmbedded() == 0)
+ {
+  sprites.SetRoot(AssetLoader::FindRoot(L"images"));
+ }
+
+ Aquarium aquarium;
+ if (!aquarium.LoadFile(argv[1]))
+ {
+  cerr << "FastForward: unable to load " << argv[1] << endl;
+  return 1;
+ }
+
+ cout << "Items: " << aquarium.GetItemCount() << ", fish: " << aquarium.GetFishStore().GetCount() << endl;
+
+ auto start = chrono::steady_clock::now();
+ auto wallSince = [&start]() { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+
+ // Time is simulated in slices only so there is progress to report
+ uint64_t steps = 0;
+ double simulated = 0;
+ for (int report = 1; report <= ProgressReports; report++)
+ {
+  auto slice = seconds * report / ProgressReports - simulated;
+  steps += aquarium.FastForward(slice);
+  simulated = double(steps) * aquarium.GetClock().GetStep();
+
+  auto wall = wallSince();
+  cout << "  " << simulated << " s simulated in " << wall << " s";
+  if (wall > 0)
+  {
+   cout << " (" << simulated / wall << " simulated s per wall s)";
+  }
+  cout << endl;
+ }
+
+ auto wall = wallSince();
+ cout << "Steps:      " << steps << endl;
+ cout << "Simulated:  " << simulated << " s" << endl;
+ cout << "Wall clock: " << wall << " s" << endl;
+ if (wall > 0)
+ {
+  cout << "Speed:      " << simulated / wall << " simulated s per wall s" << endl;
+ }
+
+ if (argc == 4)
+ {
+  if (!aquarium.Save(argv[3]))
+  {
+   cerr << "FastForward: unable to save " << argv[3] << endl;
+   return 1;
+  }
+
+  cout << "Saved " << argv[3] << endl;
+ }
+
+ return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file ReplaySession.cpp
+ * @author Yeji Lee
+ *
+ * Tool that replays a recorded session with nothing drawn, as
+ * fast as it will go, and checks it ends up where the recording did.
+ *
+ * Usage: ReplaySession session.aqsession
+ *
+ * Exits with 0 if every state hash matched, 1 if the replay went
+ * different and 2 if the log could not be read.
+ */
+
+#include <pch.h>
+#include <wx/init.h>
+#include <Aquarium.h>
+#include <AssetLoader.h>
+#include <SessionReplayer.h>
+#include <SpriteCache.h>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * Program entry point
+ * @param argc Number of arguments
+ * @param argv The arguments
+ * @return 0 if the replay matched the recording
+ */
+int main(int argc, char **argv)
+{
+ if (argc != 2)
+ {
+  cerr << "Usage: ReplaySession session.aqsession" << endl;
+  return 2;
+ }
+
+ wxInitializer initializer;
+ wxInitAllImageHandlers();
+
+ auto &sprites = SpriteCache::Instance();
+ if (sprites.LoadEmbedded() == 0)
+ {
+  sprites.SetRoot(AssetLoader::FindRoot(L"images"));
+ }
+
+ SessionReplayer replayer;
+ if (!replayer.Open(wxString(argv[1]).ToStdWstring()))
+ {
+  wcerr << L"ReplaySession: " << replayer.GetError() << endl;
+  return 2;
+ }
+
+ Aquarium aquarium;
+ bool matched = replayer.Run(aquarium);
+
+ auto wall = replayer.GetWallSeconds();
+ cout << "Frames:      " << replayer.GetFrames() << endl;
+ cout << "Commands:    " << replayer.GetCommands() << endl;
+ cout << "Checkpoints: " << replayer.GetCheckpoints() << endl;
+ cout << "Simulated:   " << replayer.GetSimulatedSeconds() << " s" << endl;
+ cout << "Wall clock:  " << wall << " s";
+ if (wall > 0)
+ {
+  cout << " (" << replayer.GetSimulatedSeconds() / wall << "x real time)";
+ }
+ cout << endl;
+
+ if (!matched)
+ {
+  wcout << L"FAILED: " << replayer.GetError() << endl;
+  return 1;
+ }
+
+ cout << "OK: final state matches the recording" << endl;
+ return 0;
+}